@@ -0,0 +1,484 @@
+/************************** ghwband.c *****************************
+
+   Band rendering for non-buffered mode, see GHW_BAND_ROWS in gdispcfg.h
+
+   Compiled when GHW_BAND_ROWS is defined (and GBUFFER is not).
+
+   ghw_band_begin() starts recording a frame. The ghw_fill(),
+   ghw_rectangle(), ghw_setpixel(), ghw_wrsym() and ghw_wrblk() calls are
+   stored in a display list of GHW_BAND_LIST bytes instead of being drawn.
+   ghw_band_end() renders the frame GHW_BAND_ROWS rows at a time:
+
+      The band buffer is cleared to the background color at
+      ghw_band_begin(). Each list entry overlapping the band is replayed
+      by calling the ghw_ function again. ghw_set_xyrange(),
+      ghw_auto_wr() and ghw_auto_rd() (ghwinit.c) then work on the band
+      buffer. The y range of each entry is clipped to the band rows
+      first (for ghw_wrsym() and ghw_wrblk() the source data is started
+      at the matching row), so an entry only costs the rows it has in
+      the band. The band is written to the display with one window and
+      one burst.
+
+   A frame replaces the whole screen, and each pixel is written once, so
+   there is no flicker and no read back.
+
+   The symbol and block data passed to ghw_wrsym() and ghw_wrblk() is
+   referenced by the list, it must be unchanged until ghw_band_end().
+
+   Other ghw_ functions (ghw_invert(), ghw_gscroll(), ghw_rdblk(), ...)
+   need the composed display content. They, a full display list, or a
+   virtual font symbol end the recording: the recorded part is rendered
+   at once and the rest of the frame is drawn directly. ghw_band_end()
+   then returns 1.
+
+*********************************************************************/
+#include <string.h>
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
+
+#ifdef GHW_BAND_ROWS
+
+#ifdef GBUFFER
+  #error GHW_BAND_ROWS can not be used with GBUFFER
+#endif
+#if (GDISPPIXW != 16)
+  #error GHW_BAND_ROWS requires GDISPPIXW 16
+#endif
+#if ((GHW_BAND_ROWS < 1) || (GHW_BAND_ROWS > GDISPH))
+  #error Illegal GHW_BAND_ROWS
+#endif
+
+#ifndef GHW_BAND_LIST
+  #define GHW_BAND_LIST 512   /* Display list size in bytes */
+#endif
+
+/* Display list entries, an op byte followed by the record */
+#define GHW_BAND_OP_FILL   1
+#define GHW_BAND_OP_RECT   2
+#define GHW_BAND_OP_PIXEL  3
+#define GHW_BAND_OP_WRSYM  4
+#define GHW_BAND_OP_WRBLK  5
+
+typedef struct
+   {
+   GXT ltx;
+   GYT lty;
+   GXT rbx;
+   GYT rby;
+   GCOLOR fore;      /* Colors at the time of the call */
+   GCOLOR back;
+   } GHW_BAND_AREA;
+
+typedef struct
+   {
+   GHW_BAND_AREA a;
+   SGUINT pattern;
+   } GHW_BAND_FILL;
+
+typedef struct
+   {
+   GHW_BAND_AREA a;
+   GCOLOR color;
+   } GHW_BAND_RECT;
+
+typedef struct
+   {
+   GXT x;
+   GYT y;
+   GCOLOR color;
+   } GHW_BAND_PIXEL;
+
+typedef struct
+   {
+   GHW_BAND_AREA a;
+   PGSYMBYTE src;
+   SGUINT bw;
+   SGUCHAR mode;
+   #ifdef GHW_FLASH_SYM
+   SGUCHAR ram;      /* src is in RAM (ghw_wrsym_ram()) */
+   #endif
+   } GHW_BAND_WRSYM;
+
+typedef struct
+   {
+   GHW_BAND_AREA a;
+   SGUCHAR *src;
+   } GHW_BAND_WRBLK;
+
+SGUCHAR ghw_band_state;                  /* GHW_BAND_OFF, _REC or _DRAW */
+
+static SGUCHAR ghw_band_list[GHW_BAND_LIST];
+static SGUINT ghw_band_used;             /* Bytes used in the list */
+static SGUCHAR ghw_band_split;           /* Recording was ended early */
+static GCOLOR ghw_band_back;              /* Frame background */
+
+/* Band buffer, pixels stored msb first as sent on the bus */
+static SGUCHAR ghw_band_buf[(GBUFINT) GHW_BAND_ROWS * GDISPW * 2];
+static GYT ghw_band_y0, ghw_band_y1;     /* Rows in the band */
+
+/* Window and position set by ghw_set_xyrange() while replaying */
+static GXT ghw_band_xb, ghw_band_xe, ghw_band_x;
+static GYT ghw_band_yb, ghw_band_ye, ghw_band_y;
+
+/********************* Recording *********************/
+
+/*
+   Start recording a frame
+*/
+void ghw_band_begin(void)
+   {
+   ghw_band_used = 0;
+   ghw_band_split = 0;
+   ghw_band_back = ghw_def_background;
+   ghw_band_state = GHW_BAND_REC;
+   }
+
+/*
+   Append an entry. Returns 1 if recorded, else the recording is ended
+   and the call must draw directly.
+*/
+static SGUCHAR ghw_band_put(SGUCHAR op, const void *rec, SGUCHAR size)
+   {
+   if (ghw_band_used + 1 + size > GHW_BAND_LIST)
+      {
+      ghw_band_sync();
+      return 0;
+      }
+   ghw_band_list[ghw_band_used] = op;
+   memcpy(&ghw_band_list[ghw_band_used+1], rec, size);
+   ghw_band_used += 1 + size;
+   return 1;
+   }
+
+static void ghw_band_area(GHW_BAND_AREA *a, GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   a->ltx = ltx;
+   a->lty = lty;
+   a->rbx = rbx;
+   a->rby = rby;
+   a->fore = ghw_def_foreground;
+   a->back = ghw_def_background;
+   }
+
+SGUCHAR ghw_band_rec_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern)
+   {
+   GHW_BAND_FILL r;
+   ghw_band_area(&r.a, ltx, lty, rbx, rby);
+   r.pattern = pattern;
+   return ghw_band_put(GHW_BAND_OP_FILL, &r, sizeof(r));
+   }
+
+SGUCHAR ghw_band_rec_rect(GXT ltx, GYT lty, GXT rbx, GYT rby, GCOLOR color)
+   {
+   GHW_BAND_RECT r;
+   ghw_band_area(&r.a, ltx, lty, rbx, rby);
+   r.color = color;
+   return ghw_band_put(GHW_BAND_OP_RECT, &r, sizeof(r));
+   }
+
+SGUCHAR ghw_band_rec_pixel(GXT x, GYT y, GCOLOR color)
+   {
+   GHW_BAND_PIXEL r;
+   r.x = x;
+   r.y = y;
+   r.color = color;
+   return ghw_band_put(GHW_BAND_OP_PIXEL, &r, sizeof(r));
+   }
+
+SGUCHAR ghw_band_rec_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGUCHAR mode)
+   {
+   GHW_BAND_WRSYM r;
+   if (src == NULL)
+      {
+      /* Virtual font, the symbol is only available now */
+      ghw_band_sync();
+      return 0;
+      }
+   ghw_band_area(&r.a, ltx, lty, rbx, rby);
+   r.src = src;
+   r.bw = bw;
+   r.mode = mode;
+   #ifdef GHW_FLASH_SYM
+   r.ram = ghw_sym_ram;
+   #endif
+   return ghw_band_put(GHW_BAND_OP_WRSYM, &r, sizeof(r));
+   }
+
+SGUCHAR ghw_band_rec_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src)
+   {
+   GHW_BAND_WRBLK r;
+   ghw_band_area(&r.a, ltx, lty, rbx, rby);
+   r.src = src;
+   return ghw_band_put(GHW_BAND_OP_WRBLK, &r, sizeof(r));
+   }
+
+/********************* Band pixel access *********************/
+
+/* Called by ghw_set_xyrange() while replaying */
+void ghw_band_xyrange(GXT xb, GYT yb, GXT xe, GYT ye)
+   {
+   ghw_band_xb = ghw_band_x = xb;
+   ghw_band_yb = ghw_band_y = yb;
+   ghw_band_xe = xe;
+   ghw_band_ye = ye;
+   }
+
+/* Advance the position n pixels in the current row, wrap like the controller */
+static void ghw_band_adv(GXT n)
+   {
+   if ((ghw_band_x += n) > ghw_band_xe)
+      {
+      ghw_band_x = ghw_band_xb;
+      ghw_band_y = (ghw_band_y >= ghw_band_ye) ? ghw_band_yb : ghw_band_y+1;
+      }
+   }
+
+static SGUCHAR *ghw_band_pos(void)
+   {
+   if ((ghw_band_y < ghw_band_y0) || (ghw_band_y > ghw_band_y1) || (ghw_band_x >= GDISPW))
+      return NULL;
+   return &ghw_band_buf[(((GBUFINT)(ghw_band_y - ghw_band_y0)) * GDISPW + ghw_band_x) * 2];
+   }
+
+/* Called by ghw_auto_wr() while replaying */
+void ghw_band_wr(GCOLOR dat)
+   {
+   SGUCHAR *p;
+   if ((p = ghw_band_pos()) != NULL)
+      {
+      p[0] = (SGUCHAR)(dat >> 8);
+      p[1] = (SGUCHAR) dat;
+      }
+   ghw_band_adv(1);
+   }
+
+/* Called by ghw_auto_wr_repeat() while replaying */
+void ghw_band_wr_repeat(GCOLOR dat, GBUFINT count)
+   {
+   SGUCHAR *p;
+   GXT n,i;
+   while (count != 0)
+      {
+      /* Rest of the window row */
+      n = ghw_band_xe - ghw_band_x + 1;
+      if (count < n)
+         n = (GXT) count;
+      if ((p = ghw_band_pos()) != NULL)
+         {
+         for (i = 0; i < n; i++)
+            {
+            *p++ = (SGUCHAR)(dat >> 8);
+            *p++ = (SGUCHAR) dat;
+            }
+         }
+      ghw_band_adv(n);
+      count -= n;
+      }
+   }
+
+/* Called by ghw_auto_rd() while replaying */
+GCOLOR ghw_band_rd(void)
+   {
+   SGUCHAR *p;
+   GCOLOR dat = ghw_band_back;
+   if ((p = ghw_band_pos()) != NULL)
+      dat = (GCOLOR)((((GCOLOR) p[0]) << 8) | p[1]);
+   ghw_band_adv(1);
+   return dat;
+   }
+
+/********************* Rendering *********************/
+
+/*
+   The part of a ghw_rectangle() outline in the band rows.
+   Draws the same pixels as the full call (a line or a dot for a
+   degenerated rectangle)
+*/
+static void ghw_band_rect(GXT ltx, GYT lty, GXT rbx, GYT rby, GCOLOR color)
+   {
+   GYT yb = (lty < ghw_band_y0) ? ghw_band_y0 : lty;
+   GYT ye = (rby > ghw_band_y1) ? ghw_band_y1 : rby;
+   if (lty >= ghw_band_y0)
+      ghw_rectangle(ltx, lty, rbx, lty, color);      /* Top line */
+   if (lty != rby)
+      {
+      ghw_rectangle(ltx, yb, ltx, ye, color);        /* Left line */
+      if (ltx != rbx)
+         {
+         ghw_rectangle(rbx, yb, rbx, ye, color);     /* Right line */
+         if (rby <= ghw_band_y1)
+            ghw_rectangle(ltx, rby, rbx, rby, color);   /* Bottom line */
+         }
+      }
+   }
+
+/*
+   The band rows of a ghw_wrblk() block, starting at the matching
+   source row
+*/
+static void ghw_band_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src)
+   {
+   PGHW_BLK_HEADER srchdr = (PGHW_BLK_HEADER) src;
+   GBUFINT bw;
+   GXT x;
+   GYT yb;
+
+   /* Limit destination range against source window size, as ghw_wrblk() */
+   if (rbx-ltx > (srchdr->rx - srchdr->lx))
+      rbx = ltx + (srchdr->rx - srchdr->lx);
+   if (rby-lty > (srchdr->ry - srchdr->ly))
+      rby = lty + (srchdr->ry - srchdr->ly);
+   if (rby < ghw_band_y0)
+      return;
+   if (rby > ghw_band_y1)
+      rby = ghw_band_y1;
+   yb = (lty < ghw_band_y0) ? ghw_band_y0 : lty;
+
+   bw = ((GBUFINT)(srchdr->rx - srchdr->lx + 1)) * 2;  /* Stored line width in bytes */
+   src = &(srchdr->dat[(GBUFINT)(yb - lty) * bw]);
+
+   ghw_set_xyrange(ltx, yb, rbx, rby);
+   for (; yb <= rby; yb++)
+      {
+      for (x = 0; x <= rbx-ltx; x++)
+         ghw_auto_wr((GCOLOR)(src[x*2] | (((GCOLOR) src[x*2+1]) << 8)));
+      src = &src[bw];
+      }
+   }
+
+/*
+   Replay the list entries overlapping the band
+*/
+static void ghw_band_replay(void)
+   {
+   SGUINT i;
+   SGUCHAR op;
+   GYT yb,ye;
+   union
+      {
+      GHW_BAND_AREA a;
+      GHW_BAND_FILL fill;
+      GHW_BAND_RECT rect;
+      GHW_BAND_PIXEL pixel;
+      GHW_BAND_WRSYM wrsym;
+      GHW_BAND_WRBLK wrblk;
+      } r;
+
+   for (i = 0; i < ghw_band_used; )
+      {
+      op = ghw_band_list[i++];
+      if (op == GHW_BAND_OP_PIXEL)
+         {
+         memcpy(&r.pixel, &ghw_band_list[i], sizeof(r.pixel));
+         i += sizeof(r.pixel);
+         if ((r.pixel.y >= ghw_band_y0) && (r.pixel.y <= ghw_band_y1))
+            ghw_setpixel(r.pixel.x, r.pixel.y, r.pixel.color);
+         continue;
+         }
+
+      switch (op)
+         {
+         case GHW_BAND_OP_FILL:  memcpy(&r.fill,  &ghw_band_list[i], sizeof(r.fill));  i += sizeof(r.fill);  break;
+         case GHW_BAND_OP_RECT:  memcpy(&r.rect,  &ghw_band_list[i], sizeof(r.rect));  i += sizeof(r.rect);  break;
+         case GHW_BAND_OP_WRSYM: memcpy(&r.wrsym, &ghw_band_list[i], sizeof(r.wrsym)); i += sizeof(r.wrsym); break;
+         default:                memcpy(&r.wrblk, &ghw_band_list[i], sizeof(r.wrblk)); i += sizeof(r.wrblk); break;
+         }
+      if ((r.a.rby < ghw_band_y0) || (r.a.lty > ghw_band_y1))
+         continue;   /* Not in this band */
+
+      ghw_def_foreground = r.a.fore;
+      ghw_def_background = r.a.back;
+      /* Only the band rows */
+      yb = (r.a.lty < ghw_band_y0) ? ghw_band_y0 : r.a.lty;
+      ye = (r.a.rby > ghw_band_y1) ? ghw_band_y1 : r.a.rby;
+      switch (op)
+         {
+         case GHW_BAND_OP_FILL:
+            ghw_fill(r.a.ltx, yb, r.a.rbx, ye, r.fill.pattern);
+            break;
+         case GHW_BAND_OP_RECT:
+            ghw_band_rect(r.a.ltx, r.a.lty, r.a.rbx, r.a.rby, r.rect.color);
+            break;
+         case GHW_BAND_OP_WRSYM:
+            /* Start at the symbol row shown at yb */
+            #ifdef GHW_FLASH_SYM
+            ghw_sym_ram = r.wrsym.ram;
+            #endif
+            ghw_wrsym(r.a.ltx, yb, r.a.rbx, ye,
+                      &r.wrsym.src[(GBUFINT)(yb - r.a.lty) * r.wrsym.bw], r.wrsym.bw, r.wrsym.mode);
+            break;
+         default:
+            ghw_band_wrblk(r.a.ltx, r.a.lty, r.a.rbx, r.a.rby, r.wrblk.src);
+            break;
+         }
+      }
+   }
+
+/*
+   Render the recorded list band by band
+*/
+static void ghw_band_render(void)
+   {
+   GCOLOR fore = ghw_def_foreground;
+   GCOLOR back = ghw_def_background;
+   GBUFINT n;
+   #ifdef GHW_FLASH_SYM
+   SGUCHAR ram = ghw_sym_ram;   /* Set by the replayed symbols */
+   #endif
+
+   for (ghw_band_y0 = 0; ghw_band_y0 < GDISPH; ghw_band_y0 += GHW_BAND_ROWS)
+      {
+      ghw_band_y1 = ghw_band_y0 + (GHW_BAND_ROWS-1);
+      if (ghw_band_y1 >= GDISPH)
+         ghw_band_y1 = GDISPH-1;
+      n = ((GBUFINT)(ghw_band_y1 - ghw_band_y0 + 1)) * GDISPW;
+
+      /* Compose the band */
+      ghw_band_state = GHW_BAND_DRAW;
+      ghw_band_xyrange(0, ghw_band_y0, GDISPW-1, ghw_band_y1);
+      ghw_band_wr_repeat(ghw_band_back, n);
+      ghw_band_replay();
+      ghw_band_state = GHW_BAND_OFF;
+
+      /* Write it */
+      GHW_STATS_ENTRY(GHW_STAT_UPDATEHW);
+      ghw_set_xyrange(0, ghw_band_y0, GDISPW-1, ghw_band_y1);
+      ghw_auto_wr_burst(ghw_band_buf, n);
+      ghw_auto_wr_end();
+      }
+
+   ghw_def_foreground = fore;
+   ghw_def_background = back;
+   #ifdef GHW_FLASH_SYM
+   ghw_sym_ram = ram;
+   #endif
+   }
+
+/*
+   End the recording now. The recorded part of the frame is rendered,
+   and the rest of the frame is drawn directly.
+   Called by the ghw_ functions which can not be recorded.
+*/
+void ghw_band_sync(void)
+   {
+   if (ghw_band_state != GHW_BAND_REC)
+      return;
+   ghw_band_render();
+   ghw_band_split = 1;
+   }
+
+/*
+   End the frame and write it to the display.
+   Returns 0 if the frame was rendered in one pass
+   Returns 1 if the recording was ended early (display list too small or
+   a function which can not be recorded was used)
+*/
+SGUCHAR ghw_band_end(void)
+   {
+   if (ghw_band_state == GHW_BAND_REC)
+      ghw_band_render();
+   ghw_band_state = GHW_BAND_OFF;
+   ghw_band_used = 0;
+   return ghw_band_split;
+   }
+
+#endif /* GHW_BAND_ROWS */
@@ -43,20 +43,11 @@
 
 *********************************************************************/
 /* <stdlib.h> is included via gdisphw.h */
-#include <s6d0129.h>   /* s6d0129 controller specific definements */
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
 
 #ifdef GBASIC_INIT_ERR
 #if (defined( GBUFFER ) || !defined(GHW_NO_LCD_READ_SUPPORT))
 
-typedef struct
-   {
-   GXT lx;
-   GYT ly;
-   GXT rx;
-   GYT ry;
-   SGUCHAR dat[1];
-   } GHW_BLK_HEADER, *PGHW_BLK_HEADER;
-
 /****************************************************************
  ** block functions
 ****************************************************************/
@@ -101,6 +92,10 @@ void ghw_rdblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *dest, GBUFINT bufsiz
    GBUF_CHECK();
    #endif
 
+   #ifdef GHW_BAND_ROWS
+   ghw_band_sync();   /* Needs the composed display content */
+   #endif
+   GHW_STATS_ENTRY(GHW_STAT_RDBLK);
    glcd_err = 0;
    if (dest == NULL)
       return;
@@ -143,7 +138,7 @@ void ghw_rdblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *dest, GBUFINT bufsiz
          {
          /* Read pixel */
          #ifdef GBUFFER
-         col = gbuf[gbufidx++];
+         col = GBUF_RD(gbufidx++);
          #else
          #ifdef GHW_NO_RDINC
          col = ghw_rd(x,lty);
@@ -199,6 +194,7 @@ void ghw_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src )
    GBUF_CHECK();
    #endif
 
+   GHW_STATS_ENTRY(GHW_STAT_WRBLK);
    glcd_err = 0;
    if (src == NULL)
       return;
@@ -211,9 +207,13 @@ void ghw_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src )
    GLIMITU(rby,GDISPH-1);
    GLIMITU(rbx,GDISPW-1);
 
+   #ifdef GHW_BAND_ROWS
+   if ((ghw_band_state == GHW_BAND_REC) && ghw_band_rec_wrblk(ltx,lty,rbx,rby,src))
+      return;
+   #endif
+
    #ifdef GBUFFER
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
+   ghw_invalrect( ltx, lty, rbx, rby );
    #endif
 
    /* Get header info about stored buffer */
@@ -266,7 +266,7 @@ void ghw_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src )
 
          /* Write pixel */
          #ifdef GBUFFER
-         gbuf[gbufidx++] = col;
+         GBUF_WR(gbufidx++, col);
          #else
          ghw_auto_wr( col );
          #endif
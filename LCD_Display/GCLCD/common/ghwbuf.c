@@ -33,14 +33,18 @@
    Revision Purpose:  ghw_flush_all() added
 
    Revision date:
-   Revision Purpose:
+   Revision Purpose:  Dirty rectangle list instead of a single bounding box
 
-   Version number: 1.02
+   Revision date:
+   Revision Purpose:  ghw_updatehw_step() time sliced flush added
+
+   Version number: 1.03
    Copyright (c) RAMTEX International Aps 2007-2018
    Web site, support and upgrade: www.ramtex.dk
 
 *********************************************************************/
-#include <s6d0129.h>    /* controller specific definements */
+#include <string.h>
+#include <s6d0129x.h>    /* controller specific definements */
 #ifdef GHW_SINGLE_CHIP
 #include <bussim.h>
 #endif
@@ -55,50 +59,595 @@
 */
 #ifdef GBUFFER
 
-void ghw_updatehw(void)
+typedef struct
    {
-   GCOLOR *cp; /* fast pointer */
-   GXT x;
+   GXT ltx,rbx;
+   GYT lty,rby;
+   } GHW_DIRTY;
 
-   if (ghw_upddelay)
+#ifdef GHW_DIRTY_TILES
+/*
+   Dirty tile bitmap
+
+   The display is divided in tiles of GHW_TILE x GHW_TILE pixels with one
+   bit pr tile (600 bits for 480x320 with 16x16 tiles). ghw_updatehw()
+   walks the tile rows and writes each horizontal run of dirty tiles with
+   one window, clipped to the bounding box iltx,ilty,irbx,irby. The flush
+   cost is bounded by the number of dirty tiles, also with many small
+   scattered updates.
+*/
+
+#ifndef GHW_TILE_SHIFT
+  #define GHW_TILE_SHIFT 4  /* 16x16 pixel tiles */
+#endif
+#define GHW_TILE        (1 << GHW_TILE_SHIFT)
+#define GHW_TILES_X     ((GDISPW + GHW_TILE - 1) >> GHW_TILE_SHIFT)
+#define GHW_TILES_Y     ((GDISPH + GHW_TILE - 1) >> GHW_TILE_SHIFT)
+
+static SGUCHAR ghw_tiles[GHW_TILES_Y][(GHW_TILES_X + 7) / 8];
+
+#define GHW_TILE_IS_DIRTY(tiles,tx,ty) (((tiles)[(ty)][(tx) >> 3] & (1 << ((tx) & 7))) != 0)
+
+static void ghw_dirty_clear(void)
+   {
+   memset(ghw_tiles, 0, sizeof(ghw_tiles));
+   }
+
+static void ghw_dirty_all(void)
+   {
+   memset(ghw_tiles, 0xff, sizeof(ghw_tiles));
+   }
+
+static void ghw_dirty_add(GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   SGUINT tx,ty,tx1,ty1;
+   tx1 = ((SGUINT) rbx) >> GHW_TILE_SHIFT;
+   ty1 = ((SGUINT) rby) >> GHW_TILE_SHIFT;
+   for (ty = ((SGUINT) lty) >> GHW_TILE_SHIFT; ty <= ty1; ty++)
+      {
+      for (tx = ((SGUINT) ltx) >> GHW_TILE_SHIFT; tx <= tx1; tx++)
+         ghw_tiles[ty][tx >> 3] |= (SGUCHAR)(1 << (tx & 7));
+      }
+   }
+
+#else /* GHW_DIRTY_TILES */
+/*
+   Dirty rectangle list
+
+   Modified areas are kept as up to GHW_DIRTY_RECTS rectangles, so areas
+   far apart (ex a clock in one corner and an icon in another) are flushed
+   separately instead of as the box around them. A new rectangle is merged
+   with a listed one when the pixels added by the union cost less than the
+   extra window setting, GHW_DIRTY_WINCOST pixels. When the list is full
+   the bounding box iltx,ilty,irbx,irby (always maintained) is flushed
+   instead.
+*/
+#ifndef GHW_DIRTY_RECTS
+  #define GHW_DIRTY_RECTS 4
+#endif
+#ifndef GHW_DIRTY_WINCOST
+  /* Window setting (CASET, RASET, RAMWR with parameters, 11 bytes) and
+     the CS / DC cycles, in pixel (2 byte) units */
+  #define GHW_DIRTY_WINCOST 8
+#endif
+#define GHW_DIRTY_OVF 0xff  /* List overflowed, the bounding box is used */
+
+static GHW_DIRTY ghw_dirty[GHW_DIRTY_RECTS];
+static SGUCHAR ghw_dirty_cnt;   /* Listed rectangles or GHW_DIRTY_OVF */
+
+static SGLONG ghw_dirty_area(GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   return ((SGLONG)(rbx - ltx) + 1) * ((SGLONG)(rby - lty) + 1);
+   }
+
+static void ghw_dirty_clear(void)
+   {
+   ghw_dirty_cnt = 0;
+   }
+
+static void ghw_dirty_all(void)
+   {
+   ghw_dirty_cnt = GHW_DIRTY_OVF;
+   }
+
+static void ghw_dirty_add(GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   GHW_DIRTY u;
+   SGLONG cost,bestcost;
+   SGUCHAR i,best;
+
+   if (ghw_dirty_cnt == GHW_DIRTY_OVF)
       return;
 
-   GBUF_CHECK();
-   glcd_err = 0;
+   /* Merge with the listed rectangles while it pays off */
+   for(;;)
+      {
+      best = ghw_dirty_cnt;
+      bestcost = GHW_DIRTY_WINCOST;
+      for (i = 0; i < ghw_dirty_cnt; i++)
+         {
+         u = ghw_dirty[i];
+         if (ltx < u.ltx) u.ltx = ltx;
+         if (lty < u.lty) u.lty = lty;
+         if (rbx > u.rbx) u.rbx = rbx;
+         if (rby > u.rby) u.rby = rby;
+         /* Pixels added by the union, negative when they overlap */
+         cost = ghw_dirty_area(u.ltx,u.lty,u.rbx,u.rby)
+              - ghw_dirty_area(ghw_dirty[i].ltx,ghw_dirty[i].lty,ghw_dirty[i].rbx,ghw_dirty[i].rby)
+              - ghw_dirty_area(ltx,lty,rbx,rby);
+         if (cost <= bestcost)
+            {
+            bestcost = cost;
+            best = i;
+            }
+         }
+      if (best == ghw_dirty_cnt)
+         break;
+      /* Take the union out of the list and try to merge it again */
+      if (ghw_dirty[best].ltx < ltx) ltx = ghw_dirty[best].ltx;
+      if (ghw_dirty[best].lty < lty) lty = ghw_dirty[best].lty;
+      if (ghw_dirty[best].rbx > rbx) rbx = ghw_dirty[best].rbx;
+      if (ghw_dirty[best].rby > rby) rby = ghw_dirty[best].rby;
+      ghw_dirty[best] = ghw_dirty[--ghw_dirty_cnt];
+      }
 
-   /* update invalid rect */
+   if (ghw_dirty_cnt >= GHW_DIRTY_RECTS)
+      {
+      ghw_dirty_cnt = GHW_DIRTY_OVF; /* Use the bounding box */
+      return;
+      }
+   ghw_dirty[ghw_dirty_cnt].ltx = ltx;
+   ghw_dirty[ghw_dirty_cnt].lty = lty;
+   ghw_dirty[ghw_dirty_cnt].rbx = rbx;
+   ghw_dirty[ghw_dirty_cnt].rby = rby;
+   ghw_dirty_cnt++;
+   }
+#endif /* GHW_DIRTY_TILES */
+
+/*
+   Mark the area ltx,lty - rbx,rby (both included) as modified
+*/
+void ghw_invalrect(GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   /* Maintain the bounding box */
    if (( irby >= ilty ) && ( irbx >= iltx ))
       {
-      if( irby >= GDISPH ) irby = GDISPH-1;
-      if( irbx >= GDISPW ) irbx = GDISPW-1;
+      if (ltx < iltx) iltx = ltx;
+      if (lty < ilty) ilty = lty;
+      if (rbx > irbx) irbx = rbx;
+      if (rby > irby) irby = rby;
+      }
+   else
+      {
+      /* First area since last flush */
+      iltx = ltx;
+      ilty = lty;
+      irbx = rbx;
+      irby = rby;
+      ghw_dirty_clear();
+      }
+   ghw_dirty_add(ltx, lty, rbx, rby);
+   }
+
+/*
+   invalrect() of the stock driver, which marks one corner at a time. The
+   corners cannot be paired without state, so the bounding box of all
+   areas is flushed instead of the list. The driver modules mark areas
+   with ghw_invalrect()
+*/
+void ghw_invalpoint(GXT x, GYT y)
+   {
+   ghw_invalrect(x, y, x, y);
+   ghw_dirty_all();
+   }
+
+#ifdef GHW_ROW_HASH
+/*
+   Row segment hashes
+
+   Each display row is divided in segments of GHW_ROW_HASH pixels and a
+   hash of the pixels last written to each segment is kept. When a whole
+   segment is to be flushed, the buffer content is hashed first and the
+   segment is skipped if the hash is unchanged. A full screen flush
+   (ghw_flush_all(), ghw_set_state()) then only writes the segments which
+   differ from what the display shows. A segment which is only partly
+   written gets the hash GHW_HASH_UNKNOWN, and so is always written by the
+   next flush.
+
+   The hash is folded to 16 bit to keep the table small (GDISPH *
+   GHW_HASH_SEGS * 2 bytes), so a changed segment gets the same hash and is skipped wrongly
+   about 1 in 65536 times. The rows y with y % GHW_ROW_HASH_REFRESH equal
+   to the flush count % GHW_ROW_HASH_REFRESH are therefore written without
+   the compare, so when the screen is flushed each frame a wrong segment
+   is shown for at most GHW_ROW_HASH_REFRESH frames. This costs
+   1/GHW_ROW_HASH_REFRESH of the rows pr flush.
 
-      /* Set both x,y ranges in advance and take advantage of
-         the controllers auto wrap features */
-      ghw_set_xyrange(iltx,ilty,irbx,irby);
+   The hashes assume the display only is written from the buffer.
+   ghw_rowhash_inval() must be called when the display is written
+   directly (ghw_bufset(), ghw_puterr()).
+
+   With GHW_XMEM_BUF the table is in its own XMEM bank (GHW_XMEM_HASH) so
+   it does not use internal RAM. The entry pointer is only valid until the
+   next buffer access, so GHW_HASH_PTR() is used for each access.
+*/
+#define GHW_HASH_SEGS    ((GDISPW + GHW_ROW_HASH - 1) / GHW_ROW_HASH)
+#define GHW_HASH_UNKNOWN 0
+
+#ifndef GHW_ROW_HASH_REFRESH
+  #define GHW_ROW_HASH_REFRESH 16
+#endif
+#if ((GHW_ROW_HASH_REFRESH < 1) || (GHW_ROW_HASH_REFRESH > 255))
+  #error Illegal GHW_ROW_HASH_REFRESH
+#endif
 
-      /* Loop rows */
-      for (;ilty <= irby; ilty++)
+#define GHW_HASH_SIZE (GDISPH * GHW_HASH_SEGS * 2L)  /* SGUINT entries */
+
+#ifdef GHW_XMEM_BUF
+  #if (GHW_HASH_SIZE > GHW_XMEM_BANK_SIZE)
+    #error The GHW_ROW_HASH table does not fit in one XMEM bank, increase GHW_ROW_HASH
+  #endif
+  #define GHW_HASH_PTR(y,s) ((SGUINT *) ghw_xmem_bptr(GHW_XMEM_HASH + \
+                              ((SGUINT)(y) * GHW_HASH_SEGS + (s)) * sizeof(SGUINT)))
+#else
+  static SGUINT ghw_hash[GDISPH][GHW_HASH_SEGS];
+  #define GHW_HASH_PTR(y,s) (&ghw_hash[(y)][(s)])
+#endif
+static SGUCHAR ghw_hash_phase;   /* Rows written without compare in this flush */
+
+void ghw_rowhash_inval(void)
+   {
+   memset(GHW_HASH_PTR(0,0), GHW_HASH_UNKNOWN, (size_t) GHW_HASH_SIZE);
+   }
+
+/*
+   Hash the buffer pixels xb..xe in row y
+*/
+static SGUINT ghw_hash_span(GXT xb, GXT xe, GYT y)
+   {
+   /* Computed with 32 bit, as in 16 bit the high color bits would only
+      reach the top bit, and folded to 16 bit */
+   SGULONG h = 5381;
+   SGUINT h16;
+   #ifdef GHW_INDEXED_BUF
+   /* Hash the colors, not the indices, so a palette change is seen */
+   GBUFINT idx = GINDEX(xb,y);
+   for (; xb <= xe; xb++)
+      h = ((h << 5) + h) ^ (SGULONG) GBUF_RD(idx++);
+   #else
+   GCOLOR *cp = GBUF_PTR( GINDEX(xb,y) );
+   for (; xb <= xe; xb++)
+      h = ((h << 5) + h) ^ (SGULONG) *cp++;
+   #endif
+   h16 = (SGUINT)(h ^ (h >> 16));
+   return (h16 == GHW_HASH_UNKNOWN) ? 1 : h16;
+   }
+#endif /* GHW_ROW_HASH */
+
+/*
+   Write the buffer pixels xb..xe in row y at the current position
+*/
+static void ghw_flush_span(GXT xb, GXT xe, GYT y)
+   {
+   #ifdef GHW_INDEXED_BUF
+   /* Expand palette indices */
+   ghw_ibuf_flush(GINDEX(xb,y), (GBUFINT)(xe-xb+1));
+   #else
+   GCOLOR *cp; /* fast pointer */
+   cp = GBUF_PTR( GINDEX(xb,y) );
+   /* Loop columns*/
+   for (; xb <= xe; xb++, cp++)
+      ghw_auto_wr(*cp);
+   #endif
+   }
+
+/*
+   Write a buffer area to the display
+*/
+static void ghw_flush_rect(GXT ltx, GYT lty, GXT rbx, GYT rby)
+   {
+   #ifdef GHW_ROW_HASH
+   SGUINT s;
+   GXT sb,se,xb,xe;
+   SGUINT h;
+   SGUCHAR win;
+   #endif
+
+   if( rby >= GDISPH ) rby = GDISPH-1;
+   if( rbx >= GDISPW ) rbx = GDISPW-1;
+
+   #ifdef GHW_ROW_HASH
+   /* win: 0 = window must be set, 1 = row window, 2 = area window */
+   win = 0;
+   for (;lty <= rby; lty++)
+      {
+      for (s = ltx / GHW_ROW_HASH; (s * GHW_ROW_HASH) <= rbx; s++)
          {
-         cp = &gbuf[ GINDEX(iltx,ilty) ];
-         /* Loop columns*/
-         for (x = iltx; x <= irbx; x++, cp++)
-            ghw_auto_wr(*cp);
+         sb = (GXT)(s * GHW_ROW_HASH);
+         se = (GXT)(sb + (GHW_ROW_HASH-1));
+         if (se >= GDISPW) se = GDISPW-1;
+         xb = (sb < ltx) ? ltx : sb;
+         xe = (se > rbx) ? rbx : se;
+         if ((xb == sb) && (xe == se))
+            {
+            h = ghw_hash_span(xb,xe,lty);
+            if ((h == *GHW_HASH_PTR(lty,s)) && ((SGUCHAR)(lty % GHW_ROW_HASH_REFRESH) != ghw_hash_phase))
+               {
+               win = 0;   /* Unchanged, skip it */
+               continue;
+               }
+            }
+         else
+            h = GHW_HASH_UNKNOWN;
+         *GHW_HASH_PTR(lty,s) = h;
+
+         if (win == 0)
+            {
+            /* From the row start the controllers auto wrap can be used
+               for the rest of the area, else the window ends with the row */
+            if (xb == ltx)
+               {
+               ghw_set_xyrange(xb,lty,rbx,rby);
+               win = 2;
+               }
+            else
+               {
+               ghw_set_xyrange(xb,lty,rbx,lty);
+               win = 1;
+               }
+            }
+         ghw_flush_span(xb,xe,lty);
          }
+      if (win == 1)
+         win = 0;
+      }
+   #else
+   /* Set both x,y ranges in advance and take advantage of
+      the controllers auto wrap features */
+   ghw_set_xyrange(ltx,lty,rbx,rby);
+
+   /* Loop rows */
+   for (;lty <= rby; lty++)
+      ghw_flush_span(ltx,rbx,lty);
+   #endif
+   }
 
-      _ghw_auto_wr_end();
+/*
+   Time sliced flush
+
+   When a flush starts, the dirty areas are moved to a flush set and the
+   dirty tracking starts over, so areas invalidated while the flush is in
+   progress are collected for the next flush. Pixels changed in an area
+   not yet written are just written with the new content, and written
+   once more by the next flush.
+
+   The flush set is written one area at a time, ghw_step_area is the area
+   being written and ghw_step_x,ghw_step_y the next pixel in it. A step
+   may end inside a row, the next step continues from ghw_step_x.
+*/
+static SGUCHAR ghw_step_busy;     /* Flush set not completed */
+static GHW_DIRTY ghw_step_area;   /* Area being written */
+static GXT ghw_step_x;            /* Next pixel in ghw_step_area */
+static GYT ghw_step_y;
+
+#ifdef GHW_DIRTY_TILES
+static SGUCHAR ghw_step_tiles[GHW_TILES_Y][(GHW_TILES_X + 7) / 8];
+static GHW_DIRTY ghw_step_box;    /* Bounding box of the flush set */
+static SGUINT ghw_step_tx;        /* Next tile to examine */
+static SGUINT ghw_step_ty;
+#else
+static GHW_DIRTY ghw_step_rect[GHW_DIRTY_RECTS];
+static SGUCHAR ghw_step_cnt;      /* Areas in the flush set */
+static SGUCHAR ghw_step_idx;      /* Next area */
+#endif
 
-      /* Invalidate dirty area range */
-      iltx = 1;
-      ilty = 1;
-      irbx = 0;
-      irby = 0;
+/*
+   Move the dirty areas to the flush set
+*/
+static void ghw_step_take(void)
+   {
+   if( irby >= GDISPH ) irby = GDISPH-1;
+   if( irbx >= GDISPW ) irbx = GDISPW-1;
+
+   #ifdef GHW_DIRTY_TILES
+   memcpy(ghw_step_tiles, ghw_tiles, sizeof(ghw_tiles));
+   ghw_step_box.ltx = iltx;
+   ghw_step_box.lty = ilty;
+   ghw_step_box.rbx = irbx;
+   ghw_step_box.rby = irby;
+   ghw_step_tx = ((SGUINT) iltx) >> GHW_TILE_SHIFT;
+   ghw_step_ty = ((SGUINT) ilty) >> GHW_TILE_SHIFT;
+   #else
+   if (ghw_dirty_cnt == GHW_DIRTY_OVF)
+      {
+      ghw_step_rect[0].ltx = iltx;
+      ghw_step_rect[0].lty = ilty;
+      ghw_step_rect[0].rbx = irbx;
+      ghw_step_rect[0].rby = irby;
+      ghw_step_cnt = 1;
       }
+   else
+      {
+      memcpy(ghw_step_rect, ghw_dirty, ghw_dirty_cnt * sizeof(GHW_DIRTY));
+      ghw_step_cnt = ghw_dirty_cnt;
+      }
+   ghw_step_idx = 0;
+   #endif
+
+   /* Invalidate dirty area range, the next ghw_invalrect() starts over */
+   iltx = 1;
+   ilty = 1;
+   irbx = 0;
+   irby = 0;
+
+   #ifdef GHW_ROW_HASH
+   /* Next rows to refresh */
+   if (++ghw_hash_phase >= GHW_ROW_HASH_REFRESH)
+      ghw_hash_phase = 0;
+   #endif
+
+   ghw_step_busy = 1;
+   ghw_step_y = 1;
+   ghw_step_area.rby = 0;   /* No area being written */
+   }
+
+/*
+   Forget the dirty areas and any flush in progress.
+   Called by ghw_init_start()
+*/
+void ghw_updatehw_reset(void)
+   {
+   iltx = 1;
+   ilty = 1;
+   irbx = 0;
+   irby = 0;
+   ghw_step_busy = 0;
+   ghw_step_y = 1;
+   ghw_step_area.rby = 0;
+   }
+
+/*
+   Select the next area of the flush set.
+   Returns 0 when the flush set is completed
+*/
+static SGUCHAR ghw_step_next(void)
+   {
+   #ifdef GHW_DIRTY_TILES
+   SGUINT tx0,tx1,ty1,xb,xe,yb,ye;
+   tx1 = ((SGUINT) ghw_step_box.rbx) >> GHW_TILE_SHIFT;
+   ty1 = ((SGUINT) ghw_step_box.rby) >> GHW_TILE_SHIFT;
+   for (; ghw_step_ty <= ty1; ghw_step_ty++, ghw_step_tx = ((SGUINT) ghw_step_box.ltx) >> GHW_TILE_SHIFT)
+      {
+      while (ghw_step_tx <= tx1)
+         {
+         if (!GHW_TILE_IS_DIRTY(ghw_step_tiles,ghw_step_tx,ghw_step_ty))
+            {
+            ghw_step_tx++;
+            continue;
+            }
+         /* Run of dirty tiles tx0..ghw_step_tx-1 */
+         tx0 = ghw_step_tx;
+         do
+            ghw_step_tx++;
+         while ((ghw_step_tx <= tx1) && GHW_TILE_IS_DIRTY(ghw_step_tiles,ghw_step_tx,ghw_step_ty));
+         xb = tx0 << GHW_TILE_SHIFT;
+         xe = (ghw_step_tx << GHW_TILE_SHIFT) - 1;
+         yb = ghw_step_ty << GHW_TILE_SHIFT;
+         ye = yb + (GHW_TILE-1);
+         if (xb < (SGUINT) ghw_step_box.ltx) xb = ghw_step_box.ltx;
+         if (xe > (SGUINT) ghw_step_box.rbx) xe = ghw_step_box.rbx;
+         if (yb < (SGUINT) ghw_step_box.lty) yb = ghw_step_box.lty;
+         if (ye > (SGUINT) ghw_step_box.rby) ye = ghw_step_box.rby;
+         ghw_step_area.ltx = (GXT) xb;
+         ghw_step_area.rbx = (GXT) xe;
+         ghw_step_area.lty = (GYT) yb;
+         ghw_step_area.rby = (GYT) ye;
+         ghw_step_x = (GXT) xb;
+         ghw_step_y = (GYT) yb;
+         return 1;
+         }
+      }
+   #else
+   if (ghw_step_idx < ghw_step_cnt)
+      {
+      ghw_step_area = ghw_step_rect[ghw_step_idx++];
+      ghw_step_x = ghw_step_area.ltx;
+      ghw_step_y = ghw_step_area.lty;
+      return 1;
+      }
+   #endif
+   ghw_step_busy = 0;
+   return 0;
+   }
+
+/*
+   Write at most budget pixels of the dirty areas. The position is kept
+   between calls, also inside a row.
+
+   Returns != 0 while there is more to write (the flush in progress or
+   areas invalidated since it started).
+
+   Call from the main loop to bound the time spent pr loop. The step also
+   writes while the update is stopped with ghw_setupdate(0), so the
+   drawing calls (which call ghw_updatehw()) leave the buffer to the
+   application's steps. ghw_updatehw() completes the flush at once, and
+   ghw_setupdate(1) completes it when the delayed update ends.
+*/
+SGUCHAR ghw_updatehw_step(GBUFINT budget)
+   {
+   GBUFINT w,rows;
+   GXT xe;
+
+   GHW_STATS_ENTRY(GHW_STAT_UPDATEHW);
+   #ifdef GHW_ALLOCATE_BUF
+   if (gbuf == NULL)
+      {
+      glcd_err = 1;   /* As GBUF_CHECK() */
+      return 0;
+      }
+   #endif
+   glcd_err = 0;
+
+   if (!ghw_step_busy && ( irby >= ilty ) && ( irbx >= iltx ))
+      ghw_step_take();
+
+   if (ghw_step_busy)
+      {
+      while (budget > 0)
+         {
+         if (ghw_step_y > ghw_step_area.rby)
+            {
+            if (!ghw_step_next())
+               break;
+            }
+         w = (GBUFINT)(ghw_step_area.rbx - ghw_step_x) + 1;
+         if ((ghw_step_x != ghw_step_area.ltx) || (budget < w))
+            {
+            /* Rest of the row, or the part of it within the budget */
+            if (w > budget)
+               w = budget;
+            xe = (GXT)(ghw_step_x + w - 1);
+            ghw_flush_rect(ghw_step_x, ghw_step_y, xe, ghw_step_y);
+            if (xe < ghw_step_area.rbx)
+               ghw_step_x = (GXT)(xe + 1);
+            else
+               {
+               ghw_step_x = ghw_step_area.ltx;
+               ghw_step_y++;
+               }
+            budget -= w;
+            }
+         else
+            {
+            /* Whole rows within the budget */
+            rows = budget / w;
+            if (rows > (GBUFINT)(ghw_step_area.rby - ghw_step_y) + 1)
+               rows = (GBUFINT)(ghw_step_area.rby - ghw_step_y) + 1;
+            ghw_flush_rect(ghw_step_area.ltx, ghw_step_y, ghw_step_area.rbx, (GYT)(ghw_step_y + rows - 1));
+            ghw_step_y = (GYT)(ghw_step_y + rows);
+            budget -= rows * w;
+            }
+         }
+
+      _ghw_auto_wr_end();  /* Release the bus between the steps */
+      }
+
    #if (defined(_WIN32) && defined(GHW_PCSIM))
    GSimFlush();
    #endif
    #if (defined(_WIN32) && defined(IOTESTER_USB))
    iot_sync(IOT_SYNC);
    #endif
+
+   return (ghw_step_busy || (( irby >= ilty ) && ( irbx >= iltx ))) ? 1 : 0;
+   }
+
+void ghw_updatehw(void)
+   {
+   if (ghw_upddelay)
+      return;   /* Delayed update, flushed by ghw_updatehw_step() or ghw_setupdate(1) */
+   /* Complete the flush in progress and the areas invalidated since */
+   while (ghw_updatehw_step(GBUFSIZE) != 0)
+      ;
    }
 
 /*
@@ -134,6 +683,7 @@ void ghw_flush_all(void)
    ilty = 0;
    irbx = GDISPW-1;
    irby = GDISPH-1;
+   ghw_dirty_all();
    /* Update hardware */
    ghw_updatehw();
    }
@@ -38,7 +38,7 @@
    Copyright (c) RAMTEX Engineering Aps 2007-2014
 
 *********************************************************************/
-#include <s6d0129.h>   /* s6d0129 controller specific definements */
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
 
 #ifdef GVIEWPORT
 
@@ -51,10 +51,15 @@ void ghw_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern)
    GYT y;
    GXT x;
    #ifdef GBUFFER
+   #ifdef GHW_INDEXED_BUF
+   GBUFINT gbufidx;
+   #else
    GCOLOR *cp;
+   #endif
    GBUF_CHECK();
    #endif
 
+   GHW_STATS_ENTRY(GHW_STAT_FILL);
    glcd_err = 0;
 
    /* Force reasonable values */
@@ -65,10 +70,18 @@ void ghw_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern)
    GLIMITD(rbx,ltx);
    GLIMITU(rbx,GDISPW-1);
 
+   #ifdef GHW_BAND_ROWS
+   if ((ghw_band_state == GHW_BAND_REC) && ghw_band_rec_fill(ltx,lty,rbx,rby,pattern))
+      return;
+   #endif
+
    #ifdef GBUFFER
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
+   ghw_invalrect( ltx, lty, rbx, rby );
    #else
+   #ifdef GHW_HW_SCROLL
+   if ((ltx == 0) && (rbx == GDISPW-1))
+      ghw_vscroll_cover(lty, rby);
+   #endif
    ghw_set_xyrange(ltx,lty,rbx,rby);
    #endif
 
@@ -76,22 +89,25 @@ void ghw_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern)
       {
       /* Accelerated loop fill for uniform color */
       GCOLOR c = (pattern != 0) ? ghw_def_foreground : ghw_def_background;
+      #ifdef GBUFFER
       for (y = lty; y <= rby; y++)
          {
-         #ifdef GBUFFER
-         cp = &gbuf[GINDEX(ltx,y)];
-         #endif
+         #ifdef GHW_INDEXED_BUF
+         ghw_ibuf_fill(GINDEX(ltx,y), (GBUFINT)(rbx-ltx+1), c);
+         #else
+         cp = GBUF_PTR(GINDEX(ltx,y));
          x = rbx-ltx;
          do
             {
-            #ifdef GBUFFER
             *cp++ = c;
-            #else
-            ghw_auto_wr(c);
-            #endif
             }
          while (x-- != 0);
+         #endif
          }
+      #else
+      /* Whole window in one repeat stream */
+      ghw_auto_wr_repeat(c, ((GBUFINT)(rbx-ltx+1)) * ((GBUFINT)(rby-lty+1)));
+      #endif
       }
    else
       {
@@ -102,12 +118,20 @@ void ghw_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern)
          pat = ((y & 1) != 0) ? (SGUCHAR)(pattern / 256) : (SGUCHAR)(pattern & 0xff);
          msk = sympixmsk[GPIXEL(ltx)];
          #ifdef GBUFFER
-         cp = &gbuf[GINDEX(ltx,y)];
+         #ifdef GHW_INDEXED_BUF
+         gbufidx = GINDEX(ltx,y);
+         #else
+         cp = GBUF_PTR(GINDEX(ltx,y));
+         #endif
          #endif
          for (x = ltx; x <= rbx; x++ )
             {
             #ifdef GBUFFER
+            #ifdef GHW_INDEXED_BUF
+            GBUF_WR(gbufidx++, (pat & msk) ? ghw_def_foreground : ghw_def_background);
+            #else
             *cp++ = (pat & msk) ? ghw_def_foreground : ghw_def_background;
+            #endif
             #else
             ghw_auto_wr(((pat & msk) ? ghw_def_foreground : ghw_def_background));
             #endif
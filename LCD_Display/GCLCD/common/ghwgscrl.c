@@ -31,7 +31,7 @@
    Copyright (c) RAMTEX Engineering Aps 2007-2014
 
 *********************************************************************/
-#include <s6d0129.h>    /* s6d0129 controller specific definements */
+#include <s6d0129x.h>    /* s6d0129 controller specific definements */
 
 #if defined( GBASIC_TEXT ) || defined(GSOFT_FONTS) || defined(GGRAPHIC)
 #if (defined( GBUFFER ) || !defined(GHW_NO_LCD_READ_SUPPORT))
@@ -45,17 +45,21 @@ void ghw_gscroll(GXT ltx, GYT lty, GXT rbx, GYT rby, GYT lines, SGUINT pattern)
    {
    #ifdef GBUFFER
    GYT ylim;
+   #if (!defined( GHW_INDEXED_BUF ) && !defined( GHW_XMEM_BUF ))
    GXT x;
+   #endif
    GBUFINT gbufidx;
    GBUFINT source;
    GBUF_CHECK();
    #else  /* GBUFFER */
    GYT ys;
-   GCOLOR *cp;
    GYT ylim;
-   GXT x;
    #endif  /* GBUFFER */
 
+   #ifdef GHW_BAND_ROWS
+   ghw_band_sync();   /* Needs the composed display content */
+   #endif
+   GHW_STATS_ENTRY(GHW_STAT_GSCROLL);
    glcd_err = 0;
 
    /* Force resoanable values */
@@ -68,8 +72,7 @@ void ghw_gscroll(GXT ltx, GYT lty, GXT rbx, GYT rby, GYT lines, SGUINT pattern)
 
    #ifdef GBUFFER
    /* Buffered mode  */
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
+   ghw_invalrect( ltx, lty, rbx, rby );
 
    if (lines > rby - lty)
       {
@@ -88,16 +91,35 @@ void ghw_gscroll(GXT ltx, GYT lty, GXT rbx, GYT rby, GYT lines, SGUINT pattern)
          }
 
       gbufidx = GINDEX(ltx,lty);
-      source = gbufidx + (GBUFINT)lines * GDISPW;
+      source = GINDEX(ltx,lty+lines);
+      #ifdef GHW_INDEXED_BUF
+      ghw_ibuf_copy(gbufidx, source, (GBUFINT)(rbx-ltx+1));
+      #elif defined( GHW_XMEM_BUF )
+      ghw_xmem_copy(gbufidx, source, (GBUFINT)(rbx-ltx+1));
+      #else
       for (x = ltx; x <= rbx; x++)
          {
          /* Loop pixel columns in row */
          gbuf[gbufidx++] = gbuf[source++];
          }
+      #endif
       }
 
    #else
    /* Non-buffered mode */
+   #ifdef GHW_HW_SCROLL
+   if ((ltx == 0) && (rbx == GDISPW-1) && (lines != 0) && (lines <= rby - lty))
+      {
+      /* Full width area, scroll with the controller and clear the
+         bottom lines like the scroll below */
+      if (ghw_vscroll(lty, rby, lines) == 0)
+         {
+         ghw_fill(ltx, (GYT)(rby-lines), rbx, rby, pattern);
+         return;
+         }
+      }
+   #endif
+
    if (lines > rby - lty)
       {
       ghw_fill(ltx, lty, rbx, rby, pattern);   /* just clear whole area */
@@ -116,24 +138,8 @@ void ghw_gscroll(GXT ltx, GYT lty, GXT rbx, GYT rby, GYT lines, SGUINT pattern)
          return;
          }
 
-      #ifdef GHW_NO_RDINC
-      ghw_set_xyrange(ltx,ys,rbx,ys);  /* Initiate LCD controller address pointers*/
-      /* Loop pixel row read */
-      for (x = ltx, cp = &ghw_tmpbuf[0]; x <= rbx; x++,cp++)
-         *cp = ghw_rd(x,ys);
-      ghw_set_xyrange(ltx,lty,rbx,lty);  /* Initiate LCD controller address pointers*/
-      #else
-      ghw_setxypos(ltx,ys);
-      ghw_auto_rd_start();
-      /* Loop pixel row read */
-      for (x = ltx, cp = &ghw_tmpbuf[0]; x <= rbx; x++,cp++)
-         *cp = ghw_auto_rd();
-      ghw_setxypos(ltx,lty);
-      #endif
-      /* Loop pixel row write */
-      for (x = ltx, cp = &ghw_tmpbuf[0]; x <= rbx; x++,cp++)
-         ghw_auto_wr(*cp);
-      ghw_auto_wr_end();
+      /* Copy row ys to row lty */
+      ghw_rmw_row(ltx, rbx, ys, lty, NULL);
       }
    #endif
    }
@@ -0,0 +1,333 @@
+/************************** ghwibuf.c *****************************
+
+   Indexed color frame buffer for buffered mode, see GHW_INDEXED_BUF in
+   gdispcfg.h
+
+   Compiled when GBUFFER and GHW_INDEXED_BUF are defined.
+
+   The frame buffer holds a palette index of GHW_INDEXED_BUF (4 or 8)
+   bits pr pixel instead of a GCOLOR, i.e. 75 KB or 150 KB instead of
+   300 KB for 480x320 pixels. The ghw_ functions access the buffer via
+   GBUF_RD() / GBUF_WR() (s6d0129x.h) and the row functions below. The
+   indices are expanded to GCOLOR by ghw_updatehw() when the dirty areas
+   are written to the display.
+
+   On the ATmega2560 the index buffer does not fit in the internal RAM,
+   so GHW_XMEM_BUF must be defined as well. The indices are then kept in
+   the external SRAM banks (ghwxmem.c). GINDEX() holds the bank in bit
+   16-23 and the pixel in the bank in bit 0-15, and a row is contiguous
+   in one bank, so the row functions below select the bank once pr row.
+   The XMEM bus takes PORTA and PORTC, so the TFT D/C and CS lines must
+   be moved to other ports first (TFT_spi.h, checked by ghwxmem.c).
+
+   4 bit pr pixel:
+      The indices refer to the 16 operative palette colors
+      (ghw_palette_opr[], loaded with ghw_palette_wr()). A color which is
+      not in the palette is stored as the nearest palette color, so the
+      palette should hold the colors used by the application.
+
+   8 bit pr pixel:
+      The indices refer to ghw_ipal[]. Entries 0-15 follow the operative
+      palette, the other entries are assigned to new colors the first
+      time they are drawn. When all entries are used, the nearest color
+      is taken.
+
+   A palette change (ghw_palette_wr()) marks the whole screen dirty so
+   the next ghw_updatehw() shows the new colors.
+
+   4 bit indices are packed with the left pixel in the high nibble.
+
+*********************************************************************/
+#include <string.h>
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
+
+#if (defined( GBUFFER ) && defined( GHW_INDEXED_BUF ))
+
+#if ((GHW_INDEXED_BUF != 4) && (GHW_INDEXED_BUF != 8))
+  #error GHW_INDEXED_BUF must be 4 or 8
+#endif
+
+#ifdef GHW_ALLOCATE_BUF
+  #error GHW_INDEXED_BUF can not be used with GHW_ALLOCATE_BUF
+#endif
+#if (defined( __AVR__ ) && !defined( GHW_XMEM_BUF ) && (GDISPW * GDISPH * 1L * GHW_INDEXED_BUF / 8 > 4096))
+  #error The GHW_INDEXED_BUF buffer does not fit in the internal RAM, define GHW_XMEM_BUF (TFT D/C and CS off PORTA / PORTC)
+#endif
+
+/* Byte holding the index of the pixel at buffer index idx */
+#define IBUF_SHIFT ((GHW_INDEXED_BUF == 4) ? 1 : 0)
+#ifdef GHW_XMEM_BUF
+  #define IBUF_PTR(idx) \
+     ghw_xmem_bptr(((idx) & ~((GBUFINT) 0xffff)) | (((SGUINT)(idx)) >> IBUF_SHIFT))
+#else
+  SGUCHAR ghw_ibuf[(GBUFSIZE * GHW_INDEXED_BUF + 7) / 8];   /* Index buffer */
+  #define IBUF_PTR(idx) (&ghw_ibuf[(idx) >> IBUF_SHIFT])
+#endif
+
+/* Pixels moved between two banks at a time by ghw_ibuf_copy() */
+#define GHW_IBUF_CHUNK 32
+
+#if (GHW_INDEXED_BUF == 4)
+  #define GHW_IPAL_SIZE 16
+  #define ghw_ipal ghw_palette_opr
+#else
+  #define GHW_IPAL_SIZE 256
+  GCOLOR ghw_ipal[GHW_IPAL_SIZE];
+  static SGUINT ghw_ipal_used = 16;   /* Entries in use */
+#endif
+
+/* Last color looked up */
+static GCOLOR ghw_ipal_col;
+static SGUCHAR ghw_ipal_idx;
+static SGUCHAR ghw_ipal_valid;
+
+/*
+   Squared distance between two colors (RGB565, red and blue scaled to
+   6 bit to weight the components equally)
+*/
+static SGULONG ghw_ipal_dist(GCOLOR c1, GCOLOR c2)
+   {
+   SGINT dr,dg,db;
+   dr = (SGINT)(((c1 >> 11) & 0x1f) - ((c2 >> 11) & 0x1f)) * 2;
+   dg = (SGINT)(((c1 >> 5)  & 0x3f) - ((c2 >> 5)  & 0x3f));
+   db = (SGINT)((c1 & 0x1f) - (c2 & 0x1f)) * 2;
+   return (SGULONG)((SGLONG) dr*dr + (SGLONG) dg*dg + (SGLONG) db*db);
+   }
+
+/*
+   Return the palette index for color
+*/
+SGUCHAR ghw_ibuf_index(GCOLOR color)
+   {
+   SGUINT i,n;
+   SGULONG d,dmin;
+
+   if (ghw_ipal_valid && (color == ghw_ipal_col))
+      return ghw_ipal_idx;
+
+   #if (GHW_INDEXED_BUF == 4)
+   n = GHW_IPAL_SIZE;
+   #else
+   n = ghw_ipal_used;
+   #endif
+
+   for (i = 0; i < n; i++)
+      {
+      if (ghw_ipal[i] == color)
+         break;
+      }
+
+   if (i >= n)
+      {
+      #if (GHW_INDEXED_BUF == 8)
+      if (n < GHW_IPAL_SIZE)
+         {
+         /* Assign a new entry */
+         ghw_ipal[n] = color;
+         ghw_ipal_used++;
+         }
+      else
+      #endif
+         {
+         /* Use the nearest color */
+         dmin = 0xffffffffUL;
+         for (n = 0; n < GHW_IPAL_SIZE; n++)
+            {
+            if ((d = ghw_ipal_dist(ghw_ipal[n], color)) < dmin)
+               {
+               dmin = d;
+               i = n;
+               }
+            }
+         }
+      }
+
+   ghw_ipal_col = color;
+   ghw_ipal_idx = (SGUCHAR) i;
+   ghw_ipal_valid = 1;
+   return (SGUCHAR) i;
+   }
+
+/*
+   Called by ghw_palette_wr() when the operative palette is changed
+*/
+void ghw_ibuf_palette(void)
+   {
+   #if (GHW_INDEXED_BUF == 8)
+   memcpy(&ghw_ipal[0], &ghw_palette_opr[0], 16*sizeof(GCOLOR));
+   #endif
+   ghw_ipal_valid = 0;
+   ghw_invalrect(0, 0, GDISPW-1, GDISPH-1);
+   }
+
+#if (GHW_INDEXED_BUF == 4)
+
+#define IBUF_GET(idx) \
+   ((SGUCHAR)((((idx) & 1) != 0) ? (*IBUF_PTR(idx) & 0x0f) : (*IBUF_PTR(idx) >> 4)))
+
+static void ghw_ibuf_set(GBUFINT idx, SGUCHAR i)
+   {
+   SGUCHAR *p = IBUF_PTR(idx);
+   if ((idx & 1) != 0)
+      *p = (SGUCHAR)((*p & 0xf0) | i);
+   else
+      *p = (SGUCHAR)((*p & 0x0f) | (i << 4));
+   }
+
+#else
+
+#define IBUF_GET(idx) (*IBUF_PTR(idx))
+#define ghw_ibuf_set(idx, i) (*IBUF_PTR(idx) = (i))
+
+#endif
+
+/*
+   Read the color of the pixel at buffer index idx
+*/
+GCOLOR ghw_ibuf_rd(GBUFINT idx)
+   {
+   return ghw_ipal[IBUF_GET(idx)];
+   }
+
+/*
+   Set the pixel at buffer index idx to color
+*/
+void ghw_ibuf_wr(GBUFINT idx, GCOLOR color)
+   {
+   ghw_ibuf_set(idx, ghw_ibuf_index(color));
+   }
+
+/*
+   Set n pixels from buffer index idx to color
+*/
+void ghw_ibuf_fill(GBUFINT idx, GBUFINT n, GCOLOR color)
+   {
+   SGUCHAR i = ghw_ibuf_index(color);
+   #if (GHW_INDEXED_BUF == 4)
+   SGUCHAR *p;
+   if (n == 0)
+      return;
+   p = IBUF_PTR(idx);
+   if ((idx & 1) != 0)
+      {
+      *p = (SGUCHAR)((*p & 0xf0) | i);
+      p++;
+      n--;
+      }
+   if (n >= 2)
+      {
+      memset(p, (i << 4) | i, (size_t)(n >> 1));
+      p += n >> 1;
+      }
+   if ((n & 1) != 0)
+      *p = (SGUCHAR)((*p & 0x0f) | (i << 4));
+   #else
+   memset(IBUF_PTR(idx), i, (size_t) n);
+   #endif
+   }
+
+/*
+   Copy n pixels from buffer index src to buffer index dst
+   (the areas must not overlap, or dst must be below src)
+*/
+void ghw_ibuf_copy(GBUFINT dst, GBUFINT src, GBUFINT n)
+   {
+   #ifdef GHW_XMEM_BUF
+   if ((SGUCHAR)(dst >> 16) != (SGUCHAR)(src >> 16))
+      {
+      /* Rows in different banks, move the indices via a small buffer */
+      SGUCHAR tmp[GHW_IBUF_CHUNK];
+      SGUCHAR i,k;
+      while (n > 0)
+         {
+         k = (n > GHW_IBUF_CHUNK) ? GHW_IBUF_CHUNK : (SGUCHAR) n;
+         for (i = 0; i < k; i++)
+            tmp[i] = IBUF_GET(src+i);
+         for (i = 0; i < k; i++)
+            ghw_ibuf_set(dst+i, tmp[i]);
+         src += k;
+         dst += k;
+         n -= k;
+         }
+      return;
+      }
+   #endif
+   #if (GHW_INDEXED_BUF == 4)
+   if (((dst ^ src) & 1) == 0)
+      {
+      /* Same nibble alignment, copy whole bytes */
+      if (((src & 1) != 0) && (n != 0))
+         {
+         ghw_ibuf_set(dst++, IBUF_GET(src));
+         src++;
+         n--;
+         }
+      if (n >= 2)
+         {
+         memmove(IBUF_PTR(dst), IBUF_PTR(src), (size_t)(n >> 1));  /* Same bank */
+         dst += n & ~((GBUFINT) 1);
+         src += n & ~((GBUFINT) 1);
+         n &= 1;
+         }
+      }
+   while (n-- > 0)
+      {
+      ghw_ibuf_set(dst++, IBUF_GET(src));
+      src++;
+      }
+   #else
+   memmove(IBUF_PTR(dst), IBUF_PTR(src), (size_t) n);  /* Same bank */
+   #endif
+   }
+
+/*
+   Swap foreground and background color for n pixels from buffer index
+   idx. Other colors are left unchanged.
+*/
+void ghw_ibuf_invert(GBUFINT idx, GBUFINT n, GCOLOR fore, GCOLOR back)
+   {
+   SGUCHAR fi,bi,i;
+   fi = ghw_ibuf_index(fore);
+   bi = ghw_ibuf_index(back);
+   for (; n > 0; n--, idx++)
+      {
+      i = IBUF_GET(idx);
+      if (i == fi)
+         ghw_ibuf_set(idx, bi);
+      else
+      if (i == bi)
+         ghw_ibuf_set(idx, fi);
+      }
+   }
+
+/*
+   Write n pixels from buffer index idx to the display at the current
+   position (ghw_set_xyrange())
+*/
+void ghw_ibuf_flush(GBUFINT idx, GBUFINT n)
+   {
+   #if (GHW_INDEXED_BUF == 4)
+   SGUCHAR *p;
+   if (n == 0)
+      return;
+   p = IBUF_PTR(idx);
+   if ((idx & 1) != 0)
+      {
+      ghw_auto_wr(ghw_ipal[*p++ & 0x0f]);
+      n--;
+      }
+   for (; n >= 2; n -= 2, p++)
+      {
+      ghw_auto_wr(ghw_ipal[*p >> 4]);
+      ghw_auto_wr(ghw_ipal[*p & 0x0f]);
+      }
+   if (n != 0)
+      ghw_auto_wr(ghw_ipal[*p >> 4]);
+   #else
+   SGUCHAR *p = IBUF_PTR(idx);
+   while (n-- > 0)
+      ghw_auto_wr(ghw_ipal[*p++]);
+   #endif
+   }
+
+#endif /* GBUFFER && GHW_INDEXED_BUF */
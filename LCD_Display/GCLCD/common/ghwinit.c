@@ -120,7 +120,8 @@
 #endif
 
 #include <gdisphw.h>  /* HW driver prototypes and types */
-#include <s6d0129.h>  /* Controller specific definements */
+#include <s6d0129x.h>  /* Controller specific definements */
+#include <ghwscript.h> /* Init script format for as1dregs */
 
 //#define WR_RD_TEST    /* Define to include write-read-back test in ghw_init() */
 
@@ -210,7 +211,8 @@
 #elif (defined( GHW_HX8346_CMDINTF ) || defined( GHW_HX8325_CMDINTF ) || \
        defined( GHW_HX8353_CMDINTF ) || defined( GHW_HX8353D_CMDINTF ) || \
        defined( GHW_SSD1355 ) || defined( GHW_ST7628 ) || \
-       defined( GHW_ILI9163 ) || defined( GHW_HX8369) || defined(GHW_ILI9488))
+       defined( GHW_ILI9163 ) || defined( GHW_HX8369) || defined(GHW_ILI9488) || \
+       defined( GHW_HX8357D ))
 
    /* Display control registers for control of primary drawing operations */
    #define GCTRL_DISPOFF   0x28
@@ -219,6 +221,14 @@
    #define GCTRL_RASET     0x2B
    #define GCTRL_RAMWR     0x2C
    #define GCTRL_RAMRD     0x2E
+   #if (defined( GHW_ILI9163 ) || defined( GHW_ILI9488 ) || defined( GHW_HX8369 ) || \
+        defined( GHW_HX8353D_CMDINTF ) || defined( GHW_HX8357D ))
+   #define GCTRL_RAMWRC    0x3C  /* Write memory continue (at address counter) */
+   #endif
+   #ifdef GHW_HX8357D
+   #define GCTRL_VSCRDEF   0x33  /* Vertical scroll area definition */
+   #define GCTRL_VSCRSADD  0x37  /* Vertical scroll start address */
+   #endif
 
    /* Display control registers for initialization only */
    #define GCTRL_RESET     0x01
@@ -275,7 +285,18 @@
 /********************* Chip access definitions *********************/
 
 #ifndef GHW_NOHDW
-   #if defined( GHW_SINGLE_CHIP)
+   #if defined( GHW_USE_TRANSPORT )
+      /* Bus access via the selected display transport (ghwtrans.h).
+         A command byte terminates any open data burst, data bytes are
+         appended to the burst until ghw_auto_wr_end() */
+      #ifndef GHW_BUS8
+         #error GHW_USE_TRANSPORT requires GHW_BUS8
+      #endif
+      #include <bussim.h>    /* GHWCMD, GHWWR, GHWRD address codes */
+      #include <ghwtrans.h>
+      #define  sgwrby(a,d) (((a) == GHWCMD) ? GHW_TR->write_cmd(d) : GHW_TR->write_data(d))
+      #define  sgrdby(a)   (GHW_TR->read_data())
+   #elif defined( GHW_SINGLE_CHIP)
       /* User defined access types and simulated register address def */
       #include <bussim.h>
       #ifdef GHW_BUS8
@@ -346,14 +367,12 @@ GCODE GFONT FCODE SYSFONT =
       /* <stdlib.h> is included via gdisphw.h */
       GCOLOR *gbuf = NULL;           /* Graphic buffer pointer */
       static SGBOOL gbuf_owner = 0;   /* Identify pointer ownership */
-   #else
+   #elif (!defined( GHW_INDEXED_BUF ) && !defined( GHW_XMEM_BUF ))
       GCOLOR gbuf[GBUFSIZE];         /* Graphic buffer */
-   #endif
+   #endif                            /* else in ghwibuf.c or ghwxmem.c */
    GXT GFAST iltx,irbx;     /* "Dirty area" speed optimizers in buffered mode */
    GYT GFAST ilty,irby;
    SGBOOL  ghw_upddelay;    /* Flag for delayed update */
-#else
-   GCOLOR ghw_tmpbuf[GDISPW]; /* Row line buffer (for block read-modify-write) */
 #endif /* GBUFFER */
 
 
@@ -384,18 +403,11 @@ void ghw_dispoff_sim( void );
 /* Bit mask values */
 GCODE SGUCHAR FCODE sympixmsk[8] = {0x80,0x40,0x20,0x10,0x08,0x04,0x02,0x01};
 
-typedef struct
-   {
-   SGUCHAR index;
-   SGUCHAR delay;
-   SGUCHAR value;
-   } S1D_REGS;
-
 #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8325_REGINTF ))
 /************************ Use register index interface *****************/
 
 /* Array of configuration descriptors, the registers are initialized in the order given in the table */
-static GCODE S1D_REGS FCODE as1dregs[] =
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
    /*
    The initialization sequence below is suitable for most display modules
@@ -408,178 +420,179 @@ static GCODE S1D_REGS FCODE as1dregs[] =
 
    It works in this way:
    Each line will initialize one configuration register with a value and
-   optionally introduce a delay after the intialization:
-      { register index,  delay (0 = no delay), register value},
+   optionally introduce a delay after the intialization (see ghwscript.h):
+      GSCR_REG( register index, register value ),
+      GSCR_REG_WAIT( register index, delay in ms, register value ),
 
    For a detailed explanation of each register the hardware manual for
    the display controller should be consulted.
    */
    /* Gamma for CMO 2.2 (better grey-scale) */
-   {0x46,  0,0x22},
-   {0x47,  0,0x22},
-   {0x48,  0,0x20},
-   {0x49,  0,0x35},
-   {0x4A,  0,0x00},
-   {0x4B,  0,0x77},
-   {0x4C,  0,0x24},
-   {0x4D,  0,0x75},
-   {0x4E,  0,0x12},
-   {0x4F,  0,0x28},
-   {0x50,  0,0x24},
-   {0x51,  0,0x44},
+   GSCR_REG(0x46,0x22),
+   GSCR_REG(0x47,0x22),
+   GSCR_REG(0x48,0x20),
+   GSCR_REG(0x49,0x35),
+   GSCR_REG(0x4A,0x00),
+   GSCR_REG(0x4B,0x77),
+   GSCR_REG(0x4C,0x24),
+   GSCR_REG(0x4D,0x75),
+   GSCR_REG(0x4E,0x12),
+   GSCR_REG(0x4F,0x28),
+   GSCR_REG(0x50,0x24),
+   GSCR_REG(0x51,0x44),
 
    /* Oscillator on */
-   {0x19, 10,0x41}, /* OSCADJ=100 010, OSD_EN=1 */
+   GSCR_REG_WAIT(0x19,10,0x41), /* OSCADJ=100 010, OSD_EN=1 */
 
    /* Display Setting */
    #ifdef GHW_INV_VDATA
-   {GCTRL_DISPMODE,  0,0x02}, /* IDMON=0, INVON=0, NORON=1, PTLON=0 */
+   GSCR_REG(GCTRL_DISPMODE,0x02), /* IDMON=0, INVON=0, NORON=1, PTLON=0 */
    #else
-   {GCTRL_DISPMODE,  0,0x06}, /* IDMON=0, INVON=1, NORON=1, PTLON=0 */
+   GSCR_REG(GCTRL_DISPMODE,0x06), /* IDMON=0, INVON=1, NORON=1, PTLON=0 */
    #endif
-   {GCTRL_MAD_CTRL, 0, (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)}, /*MY, MX, MV, ML, BGR */
+   GSCR_REG(GCTRL_MAD_CTRL,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /*MY, MX, MV, ML, BGR */
 
    /* Set disp */
-   /* {0x28,  0,0x02},  N_BP=0000 0010 */
-   /* {0x29,  0,0x02},  N_FP=0000 0010 */
-   /* {0x2A,  0,0x02},  P_BP=0000 0010 */
-   /* {0x2B,  0,0x02},  P_FP=0000 0010 */
-   /* {0x2C,  0,0x02},  I_BP=0000 0010 */
-   /* {0x2D,  0,0x02},  I_FP=0000 0010 */
-   {0x30, 40,0x08},  /* SAPS1=1000 */
+   /* GSCR_REG(0x28,0x02),  N_BP=0000 0010 */
+   /* GSCR_REG(0x29,0x02),  N_FP=0000 0010 */
+   /* GSCR_REG(0x2A,0x02),  P_BP=0000 0010 */
+   /* GSCR_REG(0x2B,0x02),  P_FP=0000 0010 */
+   /* GSCR_REG(0x2C,0x02),  I_BP=0000 0010 */
+   /* GSCR_REG(0x2D,0x02),  I_FP=0000 0010 */
+   GSCR_REG_WAIT(0x30,40,0x08), /* SAPS1=1000 */
 
    /* Set syc */
-   {0x3A,  0,0x01},  /* N_RTN=0000, N_NW=001 */
-   {0x3B,  0,0x01},  /* P_RTN=0000, P_NW=001 */
-   {0x3C,  0,0xF0},  /* I_RTN=1111, I_NW=000 */
-   {0x3D, 20,0x00},  /* DIV=00 */
+   GSCR_REG(0x3A,0x01), /* N_RTN=0000, N_NW=001 */
+   GSCR_REG(0x3B,0x01), /* P_RTN=0000, P_NW=001 */
+   GSCR_REG(0x3C,0xF0), /* I_RTN=1111, I_NW=000 */
+   GSCR_REG_WAIT(0x3D,20,0x00), /* DIV=00 */
 
    /* Vcom */
-   {0x43,  0,0x80}, /* VCOMG=1 */
-   {0x44,  0,0x20}, /* VCM=010 0000 */
-   {0x45, 10,0x0E}, /* VDV=0 1011 */
+   GSCR_REG(0x43,0x80), /* VCOMG=1 */
+   GSCR_REG(0x44,0x20), /* VCM=010 0000 */
+   GSCR_REG_WAIT(0x45,10,0x0E), /* VDV=0 1011 */
 
    /* Power Supply Setting */
-/* {0x1B, 40,0x18},    NIDSENB=0, PON=1, DK=1, XDK=0, */
-   {0x1B,  0,0x10}, /* NIDSENB=0, PON=1, DK=0, XDK=0, */
-   {0x1C,  0,0x04}, /* AP=110 */
-   {0x1D,  0,0x47}, /* VC2=100, VC1=001 */
-   {0x1E,  0,0x00}, /* VC3=000 */
-   {0x1F,  0,0x03}, /* VRH=1101 */
-   {0x20,  0,0x40}, /* BT=1000 */
-   {0x23,  0,0x95}, /* N_DC=1001 0101 */
-   {0x24,  0,0x95}, /* P_DC=1001 0101 */
-   {0x25, 40,0xFF}, /* I_DC=1111 1111 */
+/* GSCR_REG_WAIT(0x1B,40,0x18),  NIDSENB=0, PON=1, DK=1, XDK=0, */
+   GSCR_REG(0x1B,0x10), /* NIDSENB=0, PON=1, DK=0, XDK=0, */
+   GSCR_REG(0x1C,0x04), /* AP=110 */
+   GSCR_REG(0x1D,0x47), /* VC2=100, VC1=001 */
+   GSCR_REG(0x1E,0x00), /* VC3=000 */
+   GSCR_REG(0x1F,0x03), /* VRH=1101 */
+   GSCR_REG(0x20,0x40), /* BT=1000 */
+   GSCR_REG(0x23,0x95), /* N_DC=1001 0101 */
+   GSCR_REG(0x24,0x95), /* P_DC=1001 0101 */
+   GSCR_REG_WAIT(0x25,40,0xFF), /* I_DC=1111 1111 */
 
    /* VLCD_TRI=0,  0, STB=0 */
    /* VLCD_TRI=1,  0, STB=0 */
    /* Display ON Setting */
-   {0x26, 40,0x04}, /*GON=0, DTE=0, D=01 */
-   {0x26,  0,0x24}, /*GON=1, DTE=0, D=01 */
-   {0x26, 40,0x2C}, /*GON=1, DTE=0, D=11 */
-   {0x26,  0,0x3C}, /*GON=1, DTE=1, D=11 */
+   GSCR_REG_WAIT(0x26,40,0x04), /*GON=0, DTE=0, D=01 */
+   GSCR_REG(0x26,0x24), /*GON=1, DTE=0, D=01 */
+   GSCR_REG_WAIT(0x26,40,0x2C), /*GON=1, DTE=0, D=11 */
+   GSCR_REG(0x26,0x3C), /*GON=1, DTE=1, D=11 */
 
    /* Fixed the read data issue */
-   {0x57,  0,0x02}, /* TEST_Mode=1: into TEST mode */
-   {0x56,  0,0x7B}, /* tune the memory timing */
-   {0x57,  0,0x00}  /* TEST_Mode=0: exit TEST mode */
+   GSCR_REG(0x57,0x02), /* TEST_Mode=1: into TEST mode */
+   GSCR_REG(0x56,0x7B), /* tune the memory timing */
+   GSCR_REG(0x57,0x00), /* TEST_Mode=0: exit TEST mode */
+   GSCR_END
    };
 
 #elif defined( GHW_HX8347G )
    /* NOTE HX83467G uses a different register layout than HX8346 / HX8347 */
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
-   {0x2E,0,0x7F}, /*GDOFF*/
-   {0xEA,0,0x00}, /*PTBA[15:8]*/
-   {0xEB,0,0x20}, /*PTBA[7:0]*/
-   {0xEC,0,0x3C}, /*STBA[15:8]*/
-   {0xED,0,0xC4}, /*STBA[7:0]*/
-   {0xE8,0,0x50}, /*OPON[7:0]*/
-   {0xE9,0,0x38}, /*OPON1[7:0]*/
-   {0xF1,0,0x01}, /*OTPS1B*/
-   {0xF2,0,0x08}, /*GEN*/
+   GSCR_REG(0x2E,0x7F), /*GDOFF*/
+   GSCR_REG(0xEA,0x00), /*PTBA[15:8]*/
+   GSCR_REG(0xEB,0x20), /*PTBA[7:0]*/
+   GSCR_REG(0xEC,0x3C), /*STBA[15:8]*/
+   GSCR_REG(0xED,0xC4), /*STBA[7:0]*/
+   GSCR_REG(0xE8,0x50), /*OPON[7:0]*/
+   GSCR_REG(0xE9,0x38), /*OPON1[7:0]*/
+   GSCR_REG(0xF1,0x01), /*OTPS1B*/
+   GSCR_REG(0xF2,0x08), /*GEN*/
    /*Gamma 2.2 Setting*/
    /*
-   {0x40,0,0x01},
-   {0x41,0,0x1F},
-   {0x42,0,0x25},
-   {0x43,0,0x22},
-   {0x44,0,0x1E},
-   {0x45,0,0x26},
-   {0x46,0,0x35},
-   {0x47,0,0x75},
-   {0x48,0,0x06},
-   {0x49,0,0x14},
-   {0x4A,0,0x19},
-   {0x4B,0,0x1A},
-   {0x4C,0,0x17},
-   {0x50,0,0x19},
-   {0x51,0,0x21},
-   {0x52,0,0x1D},
-   {0x53,0,0x1A},
-   {0x54,0,0x20},
-   {0x55,0,0x3E},
-   {0x56,0,0x0A},
-   {0x57,0,0x4A},
-   {0x58,0,0x08},
-   {0x59,0,0x05},
-   {0x5A,0,0x06},
-   {0x5B,0,0x0B},
-   {0x5C,0,0x19},
-   {0x5D,0,0xCC},
+   GSCR_REG(0x40,0x01),
+   GSCR_REG(0x41,0x1F),
+   GSCR_REG(0x42,0x25),
+   GSCR_REG(0x43,0x22),
+   GSCR_REG(0x44,0x1E),
+   GSCR_REG(0x45,0x26),
+   GSCR_REG(0x46,0x35),
+   GSCR_REG(0x47,0x75),
+   GSCR_REG(0x48,0x06),
+   GSCR_REG(0x49,0x14),
+   GSCR_REG(0x4A,0x19),
+   GSCR_REG(0x4B,0x1A),
+   GSCR_REG(0x4C,0x17),
+   GSCR_REG(0x50,0x19),
+   GSCR_REG(0x51,0x21),
+   GSCR_REG(0x52,0x1D),
+   GSCR_REG(0x53,0x1A),
+   GSCR_REG(0x54,0x20),
+   GSCR_REG(0x55,0x3E),
+   GSCR_REG(0x56,0x0A),
+   GSCR_REG(0x57,0x4A),
+   GSCR_REG(0x58,0x08),
+   GSCR_REG(0x59,0x05),
+   GSCR_REG(0x5A,0x06),
+   GSCR_REG(0x5B,0x0B),
+   GSCR_REG(0x5C,0x19),
+   GSCR_REG(0x5D,0xCC),
    */
    /*Power Voltage Setting*/
-   {0x1B,0,0x1B}, /*VRH=4.65V*/
-   {0x1A,0,0x05}, /*BT (VGH~12V,VGL~-7V,DDVDH~5V)*/
-   {0x24,0,0x70}, /*VMH(VCOM High voltage ~4.2V)*/
-   {0x25,0,0x58}, /*VML(VCOM Low voltage -1.2V)*/
+   GSCR_REG(0x1B,0x1B), /*VRH=4.65V*/
+   GSCR_REG(0x1A,0x05), /*BT (VGH~12V,VGL~-7V,DDVDH~5V)*/
+   GSCR_REG(0x24,0x70), /*VMH(VCOM High voltage ~4.2V)*/
+   GSCR_REG(0x25,0x58), /*VML(VCOM Low voltage -1.2V)*/
    /*****VCOM offset**/
-   {0x23,0,0x7E}, /*for Flicker adjust */
+   GSCR_REG(0x23,0x7E), /*for Flicker adjust */
    /*Power on Setting*/
-   {0x18,0,0x36}, /*I/P_RADJ,N/P_RADJ, Normal mode 70Hz*/
-   {0x19,0,0x01}, /*OSC_EN='1', start Osc*/
-   {0x01,0,0x00}, /*DP_STB='0', out deep sleep*/
-   {0x1F,5,0x88}, /* GAS=1, VOMG=00, PON=0, DK=1, XDK=0, DVDH_TRI=0, STB=0*/
-   {0x1F,5,0x80}, /* GAS=1, VOMG=00, PON=0, DK=0, XDK=0, DVDH_TRI=0, STB=0*/
-   {0x1F,5,0x90}, /* GAS=1, VOMG=00, PON=1, DK=0, XDK=0, DVDH_TRI=0, STB=0*/
-   {0x1F,5,0xD0}, /* GAS=1, VOMG=10, PON=1, DK=0, XDK=0, DDVDH_TRI=0, STB=0*/
+   GSCR_REG(0x18,0x36), /*I/P_RADJ,N/P_RADJ, Normal mode 70Hz*/
+   GSCR_REG(0x19,0x01), /*OSC_EN='1', start Osc*/
+   GSCR_REG(0x01,0x00), /*DP_STB='0', out deep sleep*/
+   GSCR_REG_WAIT(0x1F,5,0x88), /* GAS=1, VOMG=00, PON=0, DK=1, XDK=0, DVDH_TRI=0, STB=0*/
+   GSCR_REG_WAIT(0x1F,5,0x80), /* GAS=1, VOMG=00, PON=0, DK=0, XDK=0, DVDH_TRI=0, STB=0*/
+   GSCR_REG_WAIT(0x1F,5,0x90), /* GAS=1, VOMG=00, PON=1, DK=0, XDK=0, DVDH_TRI=0, STB=0*/
+   GSCR_REG_WAIT(0x1F,5,0xD0), /* GAS=1, VOMG=10, PON=1, DK=0, XDK=0, DDVDH_TRI=0, STB=0*/
 
    #if (defined( GHW_BUS8 ) && ((GDISPPIXW == 24) || (GDISPPIXW == 18)))
-   {0x17,0,0x06}, /* 262k color (18=6+6+6)*/
+   GSCR_REG(0x17,0x06), /* 262k color (18=6+6+6)*/
    #elif (defined( GHW_BUS8 ) &&  (GDISPPIXW == 16))
-   {0x17,0,0x05}, /* 65k color*/
+   GSCR_REG(0x17,0x05), /* 65k color*/
    #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 16))
-   {0x17,0,0x05}, /* 65k color (16)*/
+   GSCR_REG(0x17,0x05), /* 65k color (16)*/
    #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 18))
-   {0x17,0,0x07}, /* 262k color (18=16+2)*/
+   GSCR_REG(0x17,0x07), /* 262k color (18=16+2)*/
    #elif (defined( GHW_BUS32 ) && (GDISPPIXW == 18))
-   {0x17,0,0x06}, /* 262k color (18)*/
+   GSCR_REG(0x17,0x06), /* 262k color (18)*/
    #else
      #error GHW_BUSx GDISPPIXW combination is not supported with HX8347G
    #endif
 
-   {GCTRL_MAD_CTRL,  0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)}, /*MY, MX, MV, ML, BGR */
+   GSCR_REG(GCTRL_MAD_CTRL,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /*MY, MX, MV, ML, BGR */
 
-   {0x36,0,0x09}, /*SS_P, GS_P,REV_P,BGR_P*/
+   GSCR_REG(0x36,0x09), /*SS_P, GS_P,REV_P,BGR_P*/
    /* Disp on (if these two lines are commented out, dispon is done after buffer clear) */
-   {0x28,40,0x38}, /*GON=1, DTE=1, D=1000*/
-   {0x28,0,0x3C},  /*GON=1, DTE=1, D=1100*/
+   GSCR_REG_WAIT(0x28,40,0x38), /*GON=1, DTE=1, D=1000*/
+   GSCR_REG(0x28,0x3C), /*GON=1, DTE=1, D=1100*/
    /* Display Setting */
    #ifdef GHW_INV_VDATA
-   {GCTRL_DISPMODE,  0,0x02}
+   GSCR_REG(GCTRL_DISPMODE,0x02),
    #else
-   {GCTRL_DISPMODE,  0,0x00}
+   GSCR_REG(GCTRL_DISPMODE,0x00),
    #endif
+   GSCR_END
    };
 
 #elif (defined( GHW_HX8346_CMDINTF ) || defined( GHW_HX8325_CMDINTF ))
 /************************ Use command interface *****************/
 
-#define CMD 0
-#define DAT 1
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
    /*
    The initialization sequence below is suitable for most display modules
@@ -591,292 +604,297 @@ static GCODE S1D_REGS FCODE as1dregs[] =
    sequence below with the recommended setting.
 
    It works in this way:
-   Each line will send one configuration byte to the display module and
-   optionally introduce a delay after the intialization. The first parameter
-   selects if the byte should be written to the controllers command register
-   or data register address.
-      { cmd/data select,  delay (0 = no delay), register value},
+   Each line will send one command with its parameter bytes to the display
+   module and optionally introduce a delay after the command (see ghwscript.h):
+      GSCR_CMD( command, parameter, ... ),
+      GSCR_CMD_WAIT( command, delay in ms, parameter, ... ),
 
    For a detailed explanation of each command and data the hardware manual for
    the display controller should be consulted.
    */
-   {CMD,100,GCTRL_RESET},     /* 0x01 Reset */
-   {CMD,150,GCTRL_SLPOUT},    /* 0x11 Sleep out */
-
-   {CMD,  0,GCTRL_SETOSC},   /* 0xB0 Set Internal Oscillator */
-   {DAT,  0,0x07},           /*97 */
-   {DAT,150,0x00},           /*00 */
-
-   {CMD,  0,GCTRL_NORON},     /* 0x13 Normal Display Mode On */
-   {CMD,  0,GCTRL_INVON},     /* 0x21 display inversion on */
-   {CMD, 50,GCTRL_DISPON},    /* 0x29 Display On */
-
-   {CMD,  0,GCTRL_MADCTRL},   /*0x36 Memory Access Control (mirroring) */
-   {DAT,  0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)},   /* MY,MX,MV,ML,BGR,SS,0,0 */
-
-   {CMD,  0,GCTRL_GAMSET},    /* Gamma setting */
-   {DAT,  0,0x01},            /*80 */
-
-   {CMD,  0,GCTRL_SETVCOM},   /* 0xB6 SETVCOM */
-   {DAT,  0,0x80},     /*80 */
-   {DAT,  0,0x40},     /*00~75H  VCOMH  30 */
-   {DAT, 50,0x13},     /* 00~26H Vcom amplitude    0eh */
-
-   {CMD,  0,GCTRL_SETCYC},     /* 0xB4 SETCYC */
-   {DAT,  0,0x01},    /*01 default */
-   {DAT,  0,0x01},    /*01 default */
-   {DAT,  0,0x01},    /*01 default = 00 */
-   {DAT,  0,0x00},    /*00 default */
-   {DAT,  0,0x1d},    /*1d default = 38 */
-   {DAT,  0,0x3f},    /*3f default = 03 */
-   {DAT, 30,0x3f},    /*3f default = f8 */
-
-   {CMD,  0,GCTRL_SETDISP},     /* 0xB2 SETDISP */
-   {DAT,  0,0x3C},    /*3c default =20 */
-   {DAT,  0,0x02},    /* default */
-   {DAT,  0,0x02},    /* default */
-   {DAT,  0,0x02},    /* default */
-   {DAT,  0,0x02},    /* default */
-   {DAT,  0,0x02},    /* default */
-   {DAT,  0,0x02},    /* default */
-
-   {DAT,  0,0x00},    /*00  Himax internal use */
-   {DAT,  0,0x08},    /*08 */
-   {DAT,  0,0x08},    /*08 */
-   {DAT,  0,0xB0},    /*b0 */
-   {DAT,  0,0x00},    /*00 */
-   {DAT,  0,0x00},    /*00 */
-   {DAT,  0,0x00},    /*00 */
-   {DAT,  0,0x00},    /*00 */
-   {DAT, 40,0x01},    /*01 */
-
-   {CMD,  0,GCTRL_SETPOWER}, /*0xB1 SETPOWER */
-   {DAT,  0,0x10},    /* default = 09 */
-   {DAT,  0,0x04},    /* default */
-   {DAT,  0,0x00},    /* default */
-   {DAT,  0,0x06},    /* default = 05 */
-   {DAT,  0,0x08},    /* default = 0,  Vreg1 =00~0E    3.9VBGP */
-   {DAT,  0,0x00},    /* default =40, 00 */
-   {DAT,  0,0x40},    /* default =30, 10      00~90 */
-   {DAT,  0,0x20},    /* default = be 10 */
-   {DAT,  0,0x00},    /* default = be 00 */
-   {DAT,  0,0x00},    /* default = be 00 */
+   GSCR_CMD0_WAIT(GCTRL_RESET,100), /* 0x01 Reset */
+   GSCR_CMD0_WAIT(GCTRL_SLPOUT,150), /* 0x11 Sleep out */
+
+   GSCR_CMD_WAIT(GCTRL_SETOSC,150, /* 0xB0 Set Internal Oscillator */
+      0x07, /*97 */
+      0x00), /*00 */
+
+   GSCR_CMD0(GCTRL_NORON), /* 0x13 Normal Display Mode On */
+   GSCR_CMD0(GCTRL_INVON), /* 0x21 display inversion on */
+   GSCR_CMD0_WAIT(GCTRL_DISPON,50), /* 0x29 Display On */
+
+   GSCR_CMD(GCTRL_MADCTRL, /*0x36 Memory Access Control (mirroring) */
+      (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /* MY,MX,MV,ML,BGR,SS,0,0 */
+
+   GSCR_CMD(GCTRL_GAMSET, /* Gamma setting */
+      0x01), /*80 */
+
+   GSCR_CMD_WAIT(GCTRL_SETVCOM,50, /* 0xB6 SETVCOM */
+      0x80, /*80 */
+      0x40, /*00~75H  VCOMH  30 */
+      0x13), /* 00~26H Vcom amplitude    0eh */
+
+   GSCR_CMD_WAIT(GCTRL_SETCYC,30, /* 0xB4 SETCYC */
+      0x01, /*01 default */
+      0x01, /*01 default */
+      0x01, /*01 default = 00 */
+      0x00, /*00 default */
+      0x1d, /*1d default = 38 */
+      0x3f, /*3f default = 03 */
+      0x3f), /*3f default = f8 */
+
+   GSCR_CMD_WAIT(GCTRL_SETDISP,40, /* 0xB2 SETDISP */
+      0x3C, /*3c default =20 */
+      0x02, /* default */
+      0x02, /* default */
+      0x02, /* default */
+      0x02, /* default */
+      0x02, /* default */
+      0x02, /* default */
+
+      0x00, /*00  Himax internal use */
+      0x08, /*08 */
+      0x08, /*08 */
+      0xB0, /*b0 */
+      0x00, /*00 */
+      0x00, /*00 */
+      0x00, /*00 */
+      0x00, /*00 */
+      0x01), /*01 */
+
+   GSCR_CMD(GCTRL_SETPOWER, /*0xB1 SETPOWER */
+      0x10, /* default = 09 */
+      0x04, /* default */
+      0x00, /* default */
+      0x06, /* default = 05 */
+      0x08, /* default = 0,  Vreg1 =00~0E    3.9VBGP */
+      0x00, /* default =40, 00 */
+      0x40, /* default =30, 10      00~90 */
+      0x20, /* default = be 10 */
+      0x00, /* default = be 00 */
+      0x00), /* default = be 00 */
 
 /*=================65k color================== */
    /* Gamma configuration (if different from linear) */
-   {CMD,  0,GCTRL_COLORSET},  /* 0x2d */
-   {DAT,  0,0},   /* 1 */
-   {DAT,  0,4},   /* 2 */
-   {DAT,  0,8},   /*   */
-   {DAT,  0,16},  /* 3 */
-   {DAT,  0,20},  /*   */
-   {DAT,  0,24},  /* 4 */
-   {DAT,  0,28},  /*   */
-   {DAT,  0,32},  /* 5 */
-   {DAT,  0,36},  /*   */
-   {DAT,  0,40},  /* 6 */
-   {DAT,  0,44},  /*   */
-   {DAT,  0,48},  /* 7 */
-   {DAT,  0,52},  /*   */
-   {DAT,  0,56},  /* 8 */
-   {DAT,  0,60},  /*   */
-   {DAT,  0,64},  /* 9 */
-
-   {DAT,  0,68},  /*   */
-   {DAT,  0,72},  /* 10 */
-   {DAT,  0,76},  /*   */
-   {DAT,  0,80},  /* 11 */
-   {DAT,  0,84},  /*   */
-   {DAT,  0,88},  /* 12 */
-   {DAT,  0,92},  /*   */
-   {DAT,  0,96},  /* 13 */
-   {DAT,  0,100}, /*   */
-   {DAT,  0,104}, /* 14 */
-   {DAT,  0,108}, /*   */
-   {DAT,  0,112}, /* 15 */
-   {DAT,  0,116}, /*   */
-   {DAT,  0,120}, /* 16 */
-   {DAT,  0,124}, /*   */
-   {DAT,  0,128}, /* 17 */
-
-   {DAT,  0,132}, /*   */
-   {DAT,  0,136}, /* 18 */
-   {DAT,  0,140}, /*   */
-   {DAT,  0,144}, /* 19 */
-   {DAT,  0,148}, /*   */
-   {DAT,  0,152}, /* 20 */
-   {DAT,  0,156}, /*   */
-   {DAT,  0,160}, /* 21 */
-   {DAT,  0,164}, /*   */
-   {DAT,  0,168}, /* 22 */
-   {DAT,  0,172}, /*   */
-   {DAT,  0,176}, /* 23 */
-   {DAT,  0,180}, /*   */
-   {DAT,  0,184}, /* 24 */
-   {DAT,  0,188}, /*   */
-   {DAT,  0,192}, /*   */
-
-   {DAT,  0,196}, /* 25 */
-   {DAT,  0,200}, /*   */
-   {DAT,  0,204}, /* 26 */
-   {DAT,  0,208}, /*   */
-   {DAT,  0,212}, /* 27 */
-   {DAT,  0,216}, /*   */
-   {DAT,  0,220}, /* 28 */
-   {DAT,  0,224}, /*   */
-   {DAT,  0,228}, /* 29 */
-   {DAT,  0,232}, /*   */
-   {DAT,  0,236}, /*   */
-   {DAT,  0,240}, /* 30 */
-   {DAT,  0,244}, /*   */
-   {DAT,  0,248}, /* 31 */
-   {DAT,  0,252}, /*   */
-   {DAT,  0,255}, /* 32 */
-
-   /*----------green-------- */
-   {DAT,  0,0},   /* 1 */
-   {DAT,  0,4},   /* 2 */
-   {DAT,  0,8},   /*   */
-   {DAT,  0,16},  /* 3 */
-   {DAT,  0,20},  /*   */
-   {DAT,  0,24},  /* 4 */
-   {DAT,  0,28},  /*   */
-   {DAT,  0,32},  /* 5 */
-   {DAT,  0,36},  /*   */
-   {DAT,  0,40},  /* 6 */
-   {DAT,  0,44},  /*   */
-   {DAT,  0,48},  /* 7 */
-   {DAT,  0,52},  /*   */
-   {DAT,  0,56},  /* 8 */
-   {DAT,  0,60},  /*   */
-   {DAT,  0,64},  /* 9 */
-
-   {DAT,  0,68},  /*   */
-   {DAT,  0,72},  /* 10 */
-   {DAT,  0,76},  /*   */
-   {DAT,  0,80},  /* 11 */
-   {DAT,  0,84},  /*   */
-   {DAT,  0,88},  /* 12 */
-   {DAT,  0,92},  /*   */
-   {DAT,  0,96},  /* 13 */
-   {DAT,  0,100}, /*   */
-   {DAT,  0,104}, /* 14 */
-   {DAT,  0,108}, /*   */
-   {DAT,  0,112}, /* 15 */
-   {DAT,  0,116}, /*   */
-   {DAT,  0,120}, /* 16 */
-   {DAT,  0,124}, /*   */
-   {DAT,  0,128}, /* 17 */
-
-   {DAT,  0,132}, /*   */
-   {DAT,  0,136}, /* 18 */
-   {DAT,  0,140}, /*   */
-   {DAT,  0,144}, /* 19 */
-   {DAT,  0,148}, /*   */
-   {DAT,  0,152}, /* 20 */
-   {DAT,  0,156}, /*   */
-   {DAT,  0,160}, /* 21 */
-   {DAT,  0,164}, /*   */
-   {DAT,  0,168}, /* 22 */
-   {DAT,  0,172}, /*   */
-   {DAT,  0,176}, /* 23 */
-   {DAT,  0,180}, /*   */
-   {DAT,  0,184}, /* 24 */
-   {DAT,  0,188}, /*   */
-   {DAT,  0,192}, /*   */
-
-   {DAT,  0,196}, /* 25 */
-   {DAT,  0,200}, /*   */
-   {DAT,  0,204}, /* 26 */
-   {DAT,  0,208}, /*   */
-   {DAT,  0,212}, /* 27 */
-   {DAT,  0,216}, /*   */
-   {DAT,  0,220}, /* 28 */
-   {DAT,  0,224}, /*   */
-   {DAT,  0,228}, /* 29 */
-   {DAT,  0,232}, /*   */
-   {DAT,  0,236}, /*   */
-   {DAT,  0,240}, /* 30 */
-   {DAT,  0,244}, /*   */
-   {DAT,  0,248}, /* 31 */
-   {DAT,  0,252}, /*   */
-   {DAT,  0,255}, /* 32 */
-
-/*-----------blue----------------- */
-   {DAT,  0,0},   /* 1 */
-   {DAT,  0,4},   /* 2 */
-   {DAT,  0,8},   /*   */
-   {DAT,  0,16},  /* 3 */
-   {DAT,  0,20},  /*   */
-   {DAT,  0,24},  /* 4 */
-   {DAT,  0,28},  /*   */
-   {DAT,  0,32},  /* 5 */
-   {DAT,  0,36},  /*   */
-   {DAT,  0,40},  /* 6 */
-   {DAT,  0,44},  /*   */
-   {DAT,  0,48},  /* 7 */
-   {DAT,  0,52},  /*   */
-   {DAT,  0,56},  /* 8 */
-   {DAT,  0,60},  /*   */
-   {DAT,  0,64},  /* 9 */
-
-   {DAT,  0,68},  /*   */
-   {DAT,  0,72},  /* 10 */
-   {DAT,  0,76},  /*   */
-   {DAT,  0,80},  /* 11 */
-   {DAT,  0,84},  /*   */
-   {DAT,  0,88},  /* 12 */
-   {DAT,  0,92},  /*   */
-   {DAT,  0,96},  /* 13 */
-   {DAT,  0,100}, /*   */
-   {DAT,  0,104}, /* 14 */
-   {DAT,  0,108}, /*   */
-   {DAT,  0,112}, /* 15 */
-   {DAT,  0,116}, /*   */
-   {DAT,  0,120}, /* 16 */
-   {DAT,  0,124}, /*   */
-   {DAT,  0,128}, /* 17 */
-
-   {DAT,  0,132}, /*   */
-   {DAT,  0,136}, /* 18 */
-   {DAT,  0,140}, /*   */
-   {DAT,  0,144}, /* 19 */
-   {DAT,  0,148}, /*   */
-   {DAT,  0,152}, /* 20 */
-   {DAT,  0,156}, /*   */
-   {DAT,  0,160}, /* 21 */
-   {DAT,  0,164}, /*   */
-   {DAT,  0,168}, /* 22 */
-   {DAT,  0,172}, /*   */
-   {DAT,  0,176}, /* 23 */
-   {DAT,  0,180}, /*   */
-   {DAT,  0,184}, /* 24 */
-   {DAT,  0,188}, /*   */
-   {DAT,  0,192}, /*   */
-
-   {DAT,  0,196}, /* 25 */
-   {DAT,  0,200}, /*   */
-   {DAT,  0,204}, /* 26 */
-   {DAT,  0,208}, /*   */
-   {DAT,  0,212}, /* 27 */
-   {DAT,  0,216}, /*   */
-   {DAT,  0,220}, /* 28 */
-   {DAT,  0,224}, /*   */
-   {DAT,  0,228}, /* 29 */
-   {DAT,  0,232}, /*   */
-   {DAT,  0,236}, /*   */
-   {DAT,  0,240}, /* 30 */
-   {DAT,  0,244}, /*   */
-   {DAT,  0,248}, /* 31 */
-   {DAT,  0,252}, /*   */
-   {DAT,  0,255}, /* 32 */
-
-   {CMD, 0,GCTRL_RAMWR}     /*memory write */
+   GSCR_CMD(GCTRL_COLORSET, /* 0x2d */
+      0, /* 1 */
+      4, /* 2 */
+      8, /*   */
+      16, /* 3 */
+      20, /*   */
+      24, /* 4 */
+      28, /*   */
+      32, /* 5 */
+      36, /*   */
+      40, /* 6 */
+      44, /*   */
+      48, /* 7 */
+      52, /*   */
+      56, /* 8 */
+      60, /*   */
+      64, /* 9 */
+
+      68, /*   */
+      72, /* 10 */
+      76, /*   */
+      80, /* 11 */
+      84, /*   */
+      88, /* 12 */
+      92, /*   */
+      96, /* 13 */
+      100, /*   */
+      104, /* 14 */
+      108, /*   */
+      112, /* 15 */
+      116, /*   */
+      120, /* 16 */
+      124, /*   */
+      128), /* 17 */
+
+   GSCR_DAT(
+      132, /*   */
+      136, /* 18 */
+      140, /*   */
+      144, /* 19 */
+      148, /*   */
+      152, /* 20 */
+      156, /*   */
+      160, /* 21 */
+      164, /*   */
+      168, /* 22 */
+      172, /*   */
+      176, /* 23 */
+      180, /*   */
+      184, /* 24 */
+      188, /*   */
+      192, /*   */
+
+      196, /* 25 */
+      200, /*   */
+      204, /* 26 */
+      208, /*   */
+      212, /* 27 */
+      216, /*   */
+      220, /* 28 */
+      224, /*   */
+      228, /* 29 */
+      232, /*   */
+      236, /*   */
+      240, /* 30 */
+      244, /*   */
+      248, /* 31 */
+      252, /*   */
+      255), /* 32 */
+
+      /*----------green-------- */
+   GSCR_DAT(
+      0, /* 1 */
+      4, /* 2 */
+      8, /*   */
+      16, /* 3 */
+      20, /*   */
+      24, /* 4 */
+      28, /*   */
+      32, /* 5 */
+      36, /*   */
+      40, /* 6 */
+      44, /*   */
+      48, /* 7 */
+      52, /*   */
+      56, /* 8 */
+      60, /*   */
+      64, /* 9 */
+
+      68, /*   */
+      72, /* 10 */
+      76, /*   */
+      80, /* 11 */
+      84, /*   */
+      88, /* 12 */
+      92, /*   */
+      96, /* 13 */
+      100, /*   */
+      104, /* 14 */
+      108, /*   */
+      112, /* 15 */
+      116, /*   */
+      120, /* 16 */
+      124, /*   */
+      128), /* 17 */
+
+   GSCR_DAT(
+      132, /*   */
+      136, /* 18 */
+      140, /*   */
+      144, /* 19 */
+      148, /*   */
+      152, /* 20 */
+      156, /*   */
+      160, /* 21 */
+      164, /*   */
+      168, /* 22 */
+      172, /*   */
+      176, /* 23 */
+      180, /*   */
+      184, /* 24 */
+      188, /*   */
+      192, /*   */
+
+      196, /* 25 */
+      200, /*   */
+      204, /* 26 */
+      208, /*   */
+      212, /* 27 */
+      216, /*   */
+      220, /* 28 */
+      224, /*   */
+      228, /* 29 */
+      232, /*   */
+      236, /*   */
+      240, /* 30 */
+      244, /*   */
+      248, /* 31 */
+      252, /*   */
+      255), /* 32 */
+
+      /*-----------blue----------------- */
+   GSCR_DAT(
+      0, /* 1 */
+      4, /* 2 */
+      8, /*   */
+      16, /* 3 */
+      20, /*   */
+      24, /* 4 */
+      28, /*   */
+      32, /* 5 */
+      36, /*   */
+      40, /* 6 */
+      44, /*   */
+      48, /* 7 */
+      52, /*   */
+      56, /* 8 */
+      60, /*   */
+      64, /* 9 */
+
+      68, /*   */
+      72, /* 10 */
+      76, /*   */
+      80, /* 11 */
+      84, /*   */
+      88, /* 12 */
+      92, /*   */
+      96, /* 13 */
+      100, /*   */
+      104, /* 14 */
+      108, /*   */
+      112, /* 15 */
+      116, /*   */
+      120, /* 16 */
+      124, /*   */
+      128), /* 17 */
+
+   GSCR_DAT(
+      132, /*   */
+      136, /* 18 */
+      140, /*   */
+      144, /* 19 */
+      148, /*   */
+      152, /* 20 */
+      156, /*   */
+      160, /* 21 */
+      164, /*   */
+      168, /* 22 */
+      172, /*   */
+      176, /* 23 */
+      180, /*   */
+      184, /* 24 */
+      188, /*   */
+      192, /*   */
+
+      196, /* 25 */
+      200, /*   */
+      204, /* 26 */
+      208, /*   */
+      212, /* 27 */
+      216, /*   */
+      220, /* 28 */
+      224, /*   */
+      228, /* 29 */
+      232, /*   */
+      236, /*   */
+      240, /* 30 */
+      244, /*   */
+      248, /* 31 */
+      252, /*   */
+      255), /* 32 */
+
+   GSCR_CMD0(GCTRL_RAMWR), /*memory write */
+   GSCR_END
    };
 
 #elif defined( GHW_HX8352B )
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
    /*
    The initialization sequence below is sets the basic configurations.
@@ -890,10 +908,10 @@ static GCODE S1D_REGS FCODE as1dregs[] =
    sequence below with the recommended setting.
 
    It works in this way:
-   Each line will send one configuration byte to the display module and
-   optionally introduce a delay after the intialization. The first parameter
-   selects the configuration register to update.
-      { register index,  delay (0 = no delay), register value },
+   Each line will initialize one configuration register with a value and
+   optionally introduce a delay after the intialization (see ghwscript.h):
+      GSCR_REG( register index, register value ),
+      GSCR_REG_WAIT( register index, delay in ms, register value ),
 
    Note: For the library only requirement is that the GCTRL_MAP_CTRL command
    settings tracks the gdispcfg.h mirroring and rotation settings.
@@ -904,43 +922,59 @@ static GCODE S1D_REGS FCODE as1dregs[] =
    the display controller should be consulted.
    */
    #if (defined( GHW_BUS8 ) && ((GDISPPIXW == 24) || (GDISPPIXW == 18)))
-   {0x17,0,0x06}, /* 262k color (18=6+6+6)*/
+   GSCR_REG(0x17,0x06), /* 262k color (18=6+6+6)*/
    #elif (defined( GHW_BUS8 ) &&  (GDISPPIXW == 16))
-   {0x17,0,0x05}, /* 65k color (wr: 8+8, rd: 6+6+6 ) */
+   GSCR_REG(0x17,0x05), /* 65k color (wr: 8+8, rd: 6+6+6 ) */
    #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 16))
-   {0x17,0,0x05}, /* 65k color (16) rd: (6+6)+(6+6)+(6+6)*/
+   GSCR_REG(0x17,0x05), /* 65k color (16) rd: (6+6)+(6+6)+(6+6)*/
    #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 18))
-   {0x17,0,0x07}, /* 262k color (18=16+2) rd: (6+6)+(6+6)+(6+6)*/
+   GSCR_REG(0x17,0x07), /* 262k color (18=16+2) rd: (6+6)+(6+6)+(6+6)*/
    #elif (defined( GHW_BUS32 ) && (GDISPPIXW == 18))
-   {0x17,0,0x06}, /* 262k color (18) rd: (6+6)+(6+6)+(6+6) */
+   GSCR_REG(0x17,0x06), /* 262k color (18) rd: (6+6)+(6+6)+(6+6) */
    #else
      #error GHW_BUSx GDISPPIXW combination is not supported with HX8352B
    #endif
 
-   {GCTRL_MAD_CTRL,  0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)}, /*MY, MX, MV, ML, BGR */
+   GSCR_REG(GCTRL_MAD_CTRL,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /*MY, MX, MV, ML, BGR */
 
    #ifdef GHW_INV_VDATA
-   {0x01,  0,0x02},
+   GSCR_REG(0x01,0x02),
    #else
-   {0x01,  0,0x00},
+   GSCR_REG(0x01,0x00),
    #endif
 
    /* Oscillator + power on */
-   {0x19,  6,0x01},       /* Enable oscillator */
-   {0x1f,  0,0x8c},       /* STB=0 */
-   {0x1c,  4,0x04},       /* AP = 100  (medium current) */
-   {0x1f,  4,0x84},       /* DK=0 */
-   {0x1f,  4,0x94},       /* PON=1 */
-   {0x1f,  4,0xd4}        /* VCOMG=1 */
+   GSCR_REG_WAIT(0x19,6,0x01), /* Enable oscillator */
+   GSCR_REG(0x1f,0x8c), /* STB=0 */
+   GSCR_REG_WAIT(0x1c,4,0x04), /* AP = 100  (medium current) */
+   GSCR_REG_WAIT(0x1f,4,0x84), /* DK=0 */
+   GSCR_REG_WAIT(0x1f,4,0x94), /* PON=1 */
+   GSCR_REG_WAIT(0x1f,4,0xd4), /* VCOMG=1 */
+   GSCR_END
    };
 
 #elif (defined( GHW_HX8353_CMDINTF ) || defined( GHW_HX8353D_CMDINTF ))
 /************************ Use command interface *****************/
 
-#define CMD 0
-#define DAT 1
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+#ifdef GHW_HX8353D_CMDINTF
+   #if (defined( GHW_BUS8 ) && ((GDISPPIXW == 24) || (GDISPPIXW == 18)))
+   #define COLMOD_VAL 0x06 /* 262k color (18=6+6+6)*/
+   #elif (defined( GHW_BUS8 ) &&  (GDISPPIXW == 16))
+   #define COLMOD_VAL 0x05 /* 65k color (wr: 8+8, rd: 6+6+6 ) */
+   #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 16))
+   #define COLMOD_VAL 0x05 /* 65k color (16) rd: (6+6)+(6+6)+(6+6)*/
+   #elif (defined( GHW_BUS32 ) && (GDISPPIXW == 18))
+   #define COLMOD_VAL 0x06 /* 262k color (18) rd: (6+6)+(6+6)+(6+6) */
+   #else
+     #error GHW_BUSx GDISPPIXW combination is not supported with HX8353D
+   #endif
+#else
+   /* GHW_HX8353_CMDINTF */
+   #define COLMOD_VAL 0x06 /* Always use 262k color mode (18=6+6+6)*/
+#endif
+
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
    /*
    The initialization sequence below is sets the basic configurations.
@@ -954,11 +988,10 @@ static GCODE S1D_REGS FCODE as1dregs[] =
    sequence below with the recommended setting.
 
    It works in this way:
-   Each line will send one configuration byte to the display module and
-   optionally introduce a delay after the intialization. The first parameter
-   selects if the byte should be written to the controllers command register
-   or data register address.
-      { cmd/data select,  delay (0 = no delay), register value },
+   Each line will send one command with its parameter bytes to the display
+   module and optionally introduce a delay after the command (see ghwscript.h):
+      GSCR_CMD( command, parameter, ... ),
+      GSCR_CMD_WAIT( command, delay in ms, parameter, ... ),
 
    Note: For the library only requirement is that the GCTRL_MADCTRL command
    (0x36) settings tracks the gdispcfg.h mirroring and rotation settings.
@@ -968,279 +1001,194 @@ static GCODE S1D_REGS FCODE as1dregs[] =
    For a detailed explanation of each command and data the hardware manual for
    the display controller should be consulted.
    */
-   {CMD,100,GCTRL_RESET},     /* 0x01 Reset */
-   {CMD,150,GCTRL_SLPOUT},    /* 0x11 Sleep out */
-   {CMD,100,GCTRL_IDMOFF},    /* 0x38 Idle mode off */
+   GSCR_CMD0_WAIT(GCTRL_RESET,100), /* 0x01 Reset */
+   GSCR_CMD0_WAIT(GCTRL_SLPOUT,150), /* 0x11 Sleep out */
+   GSCR_CMD0_WAIT(GCTRL_IDMOFF,100), /* 0x38 Idle mode off */
 
-   #ifdef GHW_HX8353D_CMDINTF
-   {CMD,  0,GCTRL_COLMOD},    /* 0x3A color mode for write/read */
-   #if (defined( GHW_BUS8 ) && ((GDISPPIXW == 24) || (GDISPPIXW == 18)))
-   {DAT,0,0x06}, /* 262k color (18=6+6+6)*/
-   #elif (defined( GHW_BUS8 ) &&  (GDISPPIXW == 16))
-   {DAT,0,0x05}, /* 65k color (wr: 8+8, rd: 6+6+6 ) */
-   #elif (defined( GHW_BUS16 ) && (GDISPPIXW == 16))
-   {DAT,0,0x05}, /* 65k color (16) rd: (6+6)+(6+6)+(6+6)*/
-   #elif (defined( GHW_BUS32 ) && (GDISPPIXW == 18))
-   {DAT,0,0x06}, /* 262k color (18) rd: (6+6)+(6+6)+(6+6) */
-   #else
-     #error GHW_BUSx GDISPPIXW combination is not supported with HX8353D
-   #endif
+   GSCR_CMD(GCTRL_COLMOD, COLMOD_VAL), /* 0x3A color mode for write/read */
 
-   #else
-   /* GHW_HX8353_CMDINTF */
-   {CMD,  0,GCTRL_COLMOD},    /* 0x3A color mode for write/read */
-   {DAT,0,0x06},              /* Always use 262k color mode (18=6+6+6)*/
-   #endif
-
-   {CMD,  0,GCTRL_NORON},     /* 0x13 Normal Display Mode On */
+   GSCR_CMD0(GCTRL_NORON), /* 0x13 Normal Display Mode On */
    #ifdef GHW_INV_VDATA
-   {CMD,  0,GCTRL_INVON},     /* 0x21 display inversion on */
+   GSCR_CMD0(GCTRL_INVON), /* 0x21 display inversion on */
    #endif
 
-   {CMD,  0,GCTRL_MADCTRL},   /*0x36 Memory Access Control (mirroring) */
-   {DAT,  0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)},   /* MY,MX,MV,ML,BGR,SS,0,0 */
+   GSCR_CMD(GCTRL_MADCTRL, /*0x36 Memory Access Control (mirroring) */
+      (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /* MY,MX,MV,ML,BGR,SS,0,0 */
+
+   GSCR_CMD(GCTRL_GAMSET, /* Gamma setting */
+      0x01), /*80 */
+   GSCR_END
+   };
+
+#elif defined( GHW_HX8357D )
+
+/* HX8357D, 320x480 GRAM, command interface */
+#if (GDISPPIXW == 18)
+   #define COLMOD_VAL 0x66 /* 262k color, 6+6+6 bits pr pixel */
+#elif (GDISPPIXW == 16)
+   #define COLMOD_VAL 0x55 /* 65k color, 5+6+5 bits pr pixel */
+#else
+   #error Illegal GDISPPIXW for HX8357D (must be 16 or 18)
+#endif
+
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
+   {
+   /* Power, oscillator, and gamma settings are module specific and is
+      made by the start-up script (hx8357d_init) executed by ghw_io_init().
+      Here only the settings which depends on the gdispcfg.h configuration
+      are made.
+
+      The GRAM is organized as 320 columns x 480 rows. The 480x320 display
+      configuration uses GHW_ROTATED so MV swaps the row and column address
+      counters */
+
+   GSCR_CMD(GCTRL_COLMOD, COLMOD_VAL), /* 0x3A color mode for write/read */
 
-   {CMD,  0,GCTRL_GAMSET},    /* Gamma setting */
-   {DAT,  0,0x01}             /*80 */
+   GSCR_CMD(GCTRL_MADCTRL, /*0x36 Memory Access Control (mirroring) */
+      (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /* MY,MX,MV,ML,BGR,0,0,0 */
+
+   GSCR_CMD0(GCTRL_NORON), /* 0x13 Normal Display Mode On */
+   #ifdef GHW_INV_VDATA
+   GSCR_CMD0(GCTRL_INVON), /* 0x21 display inversion on */
+   #endif
+   GSCR_END
    };
 
 #elif defined( GHW_SSD1355 )
 
-#define CMD 0
-#define DAT 1
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
-   {CMD,0,0x01}, // Software reset
+   GSCR_CMD0(0x01), // Software reset
 
-   {CMD,0,0xfd}, // Unlock extended commands
-   {DAT,0,0xb3},
+   GSCR_CMD(0xfd, 0xb3), // Unlock extended commands
 
-   {CMD,0,0xd2},  // Set display clock/ OSc freq
+   GSCR_CMD0(0xd2), // Set display clock/ OSc freq
 
-   {CMD,0,0xd3}, // Set Vcom h
-   {DAT,0,0x01}, // 0.74*VCC
+   GSCR_CMD(0xd3, // Set Vcom h
+      0x01), // 0.74*VCC
 
-   {CMD,0,0xd6}, // High power protection
-   {DAT,0,0x07},
+   GSCR_CMD(0xd6, 0x07), // High power protection
 
-   {CMD,0,0xcc}, // Enable internal VSL
-   {DAT,0,0xb0},
-   {DAT,0,0x16},
+   GSCR_CMD(0xcc, 0xb0, 0x16), // Enable internal VSL
 
-   {CMD,0,0x35}, // Enable tearing effect
-   {DAT,0,0x00},
+   GSCR_CMD(0x35, 0x00), // Enable tearing effect
 
-   {CMD,0,0xca}, // Set mux ratio
-   {DAT,0,GDISPH-1},
+   GSCR_CMD(0xca, GDISPH-1), // Set mux ratio
 
-   {CMD,0,0xbd},  // Set first precharge voltage
-   {DAT,0,0x09},
+   GSCR_CMD(0xbd, 0x09), // Set first precharge voltage
 
-   {CMD,0,0xce},  // Set Second precharge speed
-   {DAT,0,0x0e},
+   GSCR_CMD(0xce, 0x0e), // Set Second precharge speed
 
-   {CMD,0,0xcf},  // Set Second precharge speed
-   {DAT,0,0x09},
+   GSCR_CMD(0xcf, 0x09), // Set Second precharge speed
 
-   {CMD,0,0xcd},  // Set phase length
-   {DAT,0,0xff},
+   GSCR_CMD(0xcd, 0xff), // Set phase length
 
-   {CMD,0,0x51},  // Write luminence
-   {DAT,0,0xf0},  // D7-D4 = Light intensity 00 - f0
+   GSCR_CMD(0x51, // Write luminence
+      0xf0), // D7-D4 = Light intensity 00 - f0
 
-   {CMD,0,GCTRL_MADCTRL},  // Memory access control
-   {DAT,0,MY_BIT|MX_BIT|MV_BIT|RGB_BIT},
-   {DAT,0,BUSMODE|COMSPLIT},
+   GSCR_CMD(GCTRL_MADCTRL, MY_BIT|MX_BIT|MV_BIT|RGB_BIT, BUSMODE|COMSPLIT), // Memory access control
 
 //   #if ((GDISPPIXW == 16) && defined (GHW_BUS16))
    #if (GDISPPIXW == 16)
-   {CMD,0,0x3a},  // Display interface mode
-   {DAT,0,0x05},
+   GSCR_CMD(0x3a, 0x05), // Display interface mode
    #endif
 
-   {CMD,0,0x11},   // Sleep out
-   {CMD,0,0x13},   // Normal display on
+   GSCR_CMD0(0x11), // Sleep out
+   GSCR_CMD0(0x13), // Normal display on
 
    /*
    // Gamma configuration (if different from linear)
-   {CMD,0,0xbe},
-   {DAT,0,1},      // GS0
-   {DAT,0,6},
-   {DAT,0,7},
-   {DAT,0,8},
-   {DAT,0,10},
-   {DAT,0,12},
-   {DAT,0,13},
-   {DAT,0,13},
-   {DAT,0,14},
-   {DAT,0,14},
-   {DAT,0,15},
-   {DAT,0,16},
-   {DAT,0,17},
-   {DAT,0,18},
-   {DAT,0,19},
-   {DAT,0,23},
-   {DAT,0,28},
-   {DAT,0,33},
-   {DAT,0,34},
-   {DAT,0,38},
-   {DAT,0,41},
-   {DAT,0,49},
-   {DAT,0,50},
-   {DAT,0,53},
-   {DAT,0,65},
-   {DAT,0,67},
-   {DAT,0,79},
-   {DAT,0,85},
-   {DAT,0,96},
-   {DAT,0,106},
-   {DAT,0,116},
-   {DAT,0,127},
-
-   {DAT,0,1},      // GS3-
-   {DAT,0,6},
-   {DAT,0,7},
-   {DAT,0,8},
-   {DAT,0,10},
-   {DAT,0,12},
-   {DAT,0,13},
-   {DAT,0,13},
-   {DAT,0,14},
-   {DAT,0,14},
-   {DAT,0,15},
-   {DAT,0,16},
-   {DAT,0,17},
-   {DAT,0,18},
-   {DAT,0,19},
-   {DAT,0,23},
-   {DAT,0,28},
-   {DAT,0,33},
-   {DAT,0,34},
-   {DAT,0,38},
-   {DAT,0,41},
-   {DAT,0,49},
-   {DAT,0,50},
-   {DAT,0,53},
-   {DAT,0,65},
-   {DAT,0,67},
-   {DAT,0,79},
-   {DAT,0,85},
-   {DAT,0,96},
-   {DAT,0,106},
-   {DAT,0,116},
-   {DAT,0,127},
-
-   {DAT,0,1},      // GS6-
-   {DAT,0,6},
-   {DAT,0,7},
-   {DAT,0,8},
-   {DAT,0,10},
-   {DAT,0,12},
-   {DAT,0,13},
-   {DAT,0,13},
-   {DAT,0,14},
-   {DAT,0,14},
-   {DAT,0,15},
-   {DAT,0,16},
-   {DAT,0,17},
-   {DAT,0,18},
-   {DAT,0,19},
-   {DAT,0,23},
-   {DAT,0,28},
-   {DAT,0,33},
-   {DAT,0,34},
-   {DAT,0,38},
-   {DAT,0,41},
-   {DAT,0,49},
-   {DAT,0,50},
-   {DAT,0,53},
-   {DAT,0,65},
-   {DAT,0,67},
-   {DAT,0,79},
-   {DAT,0,85},
-   {DAT,0,96},
-   {DAT,0,106},
-   {DAT,0,116},
-   {DAT,0,127},
+   GSCR_CMD(0xbe,  // GS0
+      1, 6, 7, 8, 10, 12, 13, 13,
+      14, 14, 15, 16, 17, 18, 19, 23,
+      28, 33, 34, 38, 41, 49, 50, 53,
+      65, 67, 79, 85, 96, 106, 116, 127),
+   GSCR_DAT(       // GS3-
+      1, 6, 7, 8, 10, 12, 13, 13,
+      14, 14, 15, 16, 17, 18, 19, 23,
+      28, 33, 34, 38, 41, 49, 50, 53,
+      65, 67, 79, 85, 96, 106, 116, 127),
+   GSCR_DAT(       // GS6-
+      1, 6, 7, 8, 10, 12, 13, 13,
+      14, 14, 15, 16, 17, 18, 19, 23,
+      28, 33, 34, 38, 41, 49, 50, 53,
+      65, 67, 79, 85, 96, 106, 116, 127),
    */
-   {CMD,0,0x0}   // Nop
+   GSCR_CMD0(0x0), // Nop
+   GSCR_END
    };
 #elif defined( GHW_ST7628 )
 
-#define CMD 0
-#define DAT 1
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+#if (GDISPIXW == 24)
+   #define COLMOD_VAL 0x07
+#elif (GDISPIXW == 18)
+   #define COLMOD_VAL 0x06
+#else
+   #define COLMOD_VAL 0x05
+#endif
+
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
-   {CMD,100,GCTRL_RESET},     /* 0x01 Reset */
-   {CMD,150,GCTRL_SLPOUT},    /* 0x11 Sleep out */
-   {CMD,  0,GCTRL_NORON},     /* 0x13 Normal Display Mode On */
-   {CMD,  0,GCTRL_INVON},     /* 0x21 display inversion */
-   {CMD, 50,GCTRL_DISPON},    /* 0x29 Display On */
-   {CMD,  0,GCTRL_MADCTRL},   /*0x36 Memory Access Control (mirroring) */
-   {DAT,  0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)},   /* MY,MX,MV,ML,BGR,0,0,0 */
-
-   {CMD,  0,0xb0},      /* Duty cycle set */
-   {DAT,  0,GDISPH-1},
-
-   {CMD,  0,0x25},      /* Contrast */
-   {DAT,  0,0x3f},      /* 0-7f (0x3f = reset default) */
-
-   {CMD,  0,GCTRL_COLMOD},
-   #if (GDISPIXW == 24)
-   {DAT,  0,0x07},
-   #elif (GDISPIXW == 18)
-   {DAT,  0,0x06},
-   #else
-   {DAT,  0,0x05},
-   #endif
+   GSCR_CMD0_WAIT(GCTRL_RESET,100), /* 0x01 Reset */
+   GSCR_CMD0_WAIT(GCTRL_SLPOUT,150), /* 0x11 Sleep out */
+   GSCR_CMD0(GCTRL_NORON), /* 0x13 Normal Display Mode On */
+   GSCR_CMD0(GCTRL_INVON), /* 0x21 display inversion */
+   GSCR_CMD0_WAIT(GCTRL_DISPON,50), /* 0x29 Display On */
+   GSCR_CMD(GCTRL_MADCTRL, /*0x36 Memory Access Control (mirroring) */
+      (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /* MY,MX,MV,ML,BGR,0,0,0 */
+
+   GSCR_CMD(0xb0, GDISPH-1), /* Duty cycle set */
+
+   GSCR_CMD(0x25, /* Contrast */
+      0x3f), /* 0-7f (0x3f = reset default) */
+
+   GSCR_CMD(GCTRL_COLMOD, COLMOD_VAL),
+   GSCR_END
    };
 #elif (defined( GHW_ILI9163 ) || defined( GHW_ILI9488 ))  /* or ILI9341 or NT39122 or ST7735 */
-#define CMD 0
-#define DAT 1
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+#if ((GDISPPIXW == 24) && defined (GHW_ILI9488))
+   #define COLMOD_VAL 0x77    /* ILI9488 support 24 bit bus mode */
+#elif (GDISPPIXW == 18)
+   #define COLMOD_VAL 0x66    /* (ST7735 only use 0x06) */
+#else
+   #define COLMOD_VAL 0x55    /* (ST7735 only use 0x05)  */
+#endif
+
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
-   {CMD,120,0x00},         /* NOP, wait for any hardware startup completed */
-   {CMD,120,GCTRL_RESET},  /* Reset registers to default */
-   {CMD,120,GCTRL_SLPOUT}, /* Exit any sleep mode, copy vendor specific default setup to registers */
+   GSCR_CMD0_WAIT(0x00,120), /* NOP, wait for any hardware startup completed */
+   GSCR_CMD0_WAIT(GCTRL_RESET,120), /* Reset registers to default */
+   GSCR_CMD0_WAIT(GCTRL_SLPOUT,120), /* Exit any sleep mode, copy vendor specific default setup to registers */
 
-   {CMD,  0,GCTRL_GAMSET},  /* Set gamma curve 3 */
-   {DAT,  0,0x04},
+   GSCR_CMD(GCTRL_GAMSET, 0x04), /* Set gamma curve 3 */
 
-   {CMD,  0,GCTRL_MADCTRL},  /* Set video buffer scan modes */
-   {DAT,  0,  MV_BIT | RGB_BIT | MX_BIT | MY_BIT }, /* Rotation, x,y mirroring, rgb-bgr modes */
+   GSCR_CMD(GCTRL_MADCTRL, /* Set video buffer scan modes */
+      MV_BIT | RGB_BIT | MX_BIT | MY_BIT), /* Rotation, x,y mirroring, rgb-bgr modes */
 
    #ifdef GHW_INV_VDATA
-   {CMD,  0,0x21},
+   GSCR_CMD0(0x21),
    #else
-   {CMD,  0,0x20},
+   GSCR_CMD0(0x20),
    #endif
 
    /* // For (for ILI9341, ILI9488 etc Adjust frame rate controls (if hardware reset / vendor defaults result in screen flickering)
-   {CMD,  0,0xB1},
-   {DAT,  0,0x00},
-   {DAT,  0,0x1d},   // frequency 65 Hz (Check data sheet for the specific variant for exact config value options)
+   GSCR_CMD(0xB1,
+      0x00,
+      0x1d),   // frequency 65 Hz (Check data sheet for the specific variant for exact config value options)
    */
 
-   {CMD,  0,GCTRL_COLMOD},  /*Pixel format */
-   #if ((GDISPPIXW == 24) && defined (GHW_ILI9488))
-   {DAT,0,0x77},    /* ILI9488 support 24 bit bus mode */
-   #elif (GDISPPIXW == 18)
-   {DAT,  0,0x66},  /* (ST7735 only use 0x06) */
-   #else
-   {DAT,  0,0x55},  /* (ST7735 only use 0x05)  */
-   #endif
+   GSCR_CMD(GCTRL_COLMOD, COLMOD_VAL), /*Pixel format */
 
-   {CMD,  0,GCTRL_DISPOFF}  //display off
-//   {CMD,  0, GCTRL_DISPON}  /*  Easier to debug when on initially */
+   GSCR_CMD0(GCTRL_DISPOFF), //display off
+//   GSCR_CMD0(GCTRL_DISPON),  /*  Easier to debug when on initially */
+   GSCR_END
    };
 
 #elif defined( GHW_HX8369 )
 
- #define CMD 0
- #define DAT 1
 
 #if defined(GHW_ROTATED)
   #define __GDISPW GDISPH
@@ -1250,133 +1198,94 @@ static GCODE S1D_REGS FCODE as1dregs[] =
   #define __GDISPH GDISPH
 #endif
 
+// Select scan resolution
+#if (__GDISPH > 854)
+  #define REG_SEL 0x00  // REG_SEL 480x864
+#elif (__GDISPH > 800)
+  #define REG_SEL 0x10  // REG_SEL 480x854
+#elif (__GDISPH > 720)
+  #define REG_SEL 0x20  // REG_SEL 480x800
+#elif (__GDISPH > 640)
+  #define REG_SEL 0x50  // REG_SEL 480x864
+#elif (__GDISPH > 854) && (__GDISPW > 360)
+  #define REG_SEL 0x30  // REG_SEL 480x640
+#else
+  #define REG_SEL 0x40  // REG_SEL 360x640
+#endif
+
+#if (GDISPPIXW == 24)
+  #define COLMOD_VAL 0x77
+#elif (GDISPPIXW == 18)
+  #define COLMOD_VAL 0x66
+#elif (GDISPPIXW == 16)
+  #define COLMOD_VAL 0x55
+#else
+  #error GHW_BUSx GDISPPIXW mode with HX8369
+#endif
 
-static GCODE S1D_REGS FCODE as1dregs[] =
+
+static GCODE SGUCHAR GSCR_FLASH as1dregs[] =
    {
-   {CMD,1000,0x00}, // Nop, (assure power on delay after hdw reset)
-   {CMD,10,GCTRL_RESET}, // Software reset
-
-   {CMD,0,0xB9},//SETEXTC Open for extention commands (3 byte key)
-   {DAT,0,0xFF},
-   {DAT,0,0x83},
-   {DAT,0,0x69},
-
-   {CMD,0,GCTRL_SETPOWER},//SETPOWER
-   {DAT,0,0x01},
-   {DAT,0,0x00},
-   {DAT,0,0x34},
-   {DAT,0,0x06},
-   {DAT,0,0x00},
-   {DAT,0,0x0F},
-   {DAT,0,0x0F},
-   {DAT,0,0x2A},
-   {DAT,0,0x32},
-   {DAT,0,0x3F},
-   {DAT,0,0x3F},
-   {DAT,0,0x07},
-   {DAT,0,0x23},
-   {DAT,0,0x01},
-   {DAT,0,0xE6},
-   {DAT,0,0xE6},
-   {DAT,0,0xE6},
-   {DAT,0,0xE6},
-   {DAT,0,0xE6},
-
-   {CMD,0,GCTRL_SETDISP},//SETDISP
-   {DAT,0,0x00},
-   // Select scan resolution
-   #if (__GDISPH > 854)
-   {DAT,0,0x00},  // REG_SEL 480x864
-   #elif (__GDISPH > 800)
-   {DAT,0,0x10},  // REG_SEL 480x854
-   #elif (__GDISPH > 720)
-   {DAT,0,0x20},  // REG_SEL 480x800
-   #elif (__GDISPH > 640)
-   {DAT,0,0x50},  // REG_SEL 480x864
-   #elif (__GDISPH > 854) && (__GDISPW > 360)
-   {DAT,0,0x30},  // REG_SEL 480x640
-   #else
-   {DAT,0,0x40},  // REG_SEL 360x640
-   #endif
-   {DAT,0,0x0A},
-   {DAT,0,0x0A},
-   {DAT,0,0x70},
-   {DAT,0,0x00},
-   {DAT,0,0xFF},
-   {DAT,0,0x00},
-   {DAT,0,0x00},
-   {DAT,0,0x00},
-   {DAT,0,0x00},
-   {DAT,0,0x03},
-   {DAT,0,0x03},
-   {DAT,0,0x00},
-   {DAT,0,0x01},
-
-   {CMD,0,GCTRL_SETCYC},//SETCYC
-   {DAT,0,0x00},
-   {DAT,0,0x18},
-   {DAT,0,0x80},
-   {DAT,0,0x10},
-   {DAT,0,0x01},
-
-   {CMD,0,GCTRL_SETVCOM},//SETVCOM
-   {DAT,0,0x2C},
-   {DAT,0,0x2C},
-
-   {CMD,0,0xD5},//SETGIP  (
-   {DAT,0,0x00},
-   {DAT,0,0x05},
-   {DAT,0,0x03},
-   {DAT,0,0x00},
-   {DAT,0,0x01},
-   {DAT,0,0x09},
-   {DAT,0,0x10},
-   {DAT,0,0x80},
-   {DAT,0,0x37},
-   {DAT,0,0x37},
-   {DAT,0,0x20},
-   {DAT,0,0x31},
-   {DAT,0,0x46},
-   {DAT,0,0x8A},
-   {DAT,0,0x57},
-   {DAT,0,0x9B},
-   {DAT,0,0x20},
-   {DAT,0,0x31},
-   {DAT,0,0x46},
-   {DAT,0,0x8A},
-   {DAT,0,0x57},
-   {DAT,0,0x9B},
-   {DAT,0,0x07},
-   {DAT,0,0x0F},
-   {DAT,0,0x02},
-   {DAT,0,0x00},
-
-   {CMD,0,GCTRL_COLMOD}, //COLMOD
-   #if (GDISPPIXW == 24)
-   {DAT,0,0x77},
-   #elif (GDISPPIXW == 18)
-   {DAT,0,0x66},
-   #elif (GDISPPIXW == 16)
-   {DAT,0,0x55},
-   #else
-     #error GHW_BUSx GDISPPIXW mode with HX8369
-   #endif
+   GSCR_CMD0_WAIT(0x00,1000), // Nop, (assure power on delay after hdw reset)
+   GSCR_CMD0_WAIT(GCTRL_RESET,10), // Software reset
+
+   GSCR_CMD(0xB9, 0xFF, 0x83, 0x69), //SETEXTC Open for extention commands (3 byte key)
 
-   {CMD,0,GCTRL_MADCTRL},//MADCTL
-   {DAT,0,(MY_BIT|MX_BIT|MV_BIT|RGB_BIT)},   /* MY,MX,MV,ML,BGR,0,0,0 */
+   GSCR_CMD(GCTRL_SETPOWER, //SETPOWER
+      0x01, 0x00, 0x34, 0x06, 0x00, 0x0F, 0x0F, 0x2A,
+      0x32, 0x3F, 0x3F, 0x07, 0x23, 0x01, 0xE6, 0xE6,
+      0xE6, 0xE6, 0xE6),
 
-   {CMD,1000,GCTRL_SLPOUT},//SLPOUT
+   GSCR_CMD(GCTRL_SETDISP, //SETDISP
+      0x00, REG_SEL, // Select scan resolution
+      0x0A, 0x0A, 0x70, 0x00, 0xFF, 0x00, 0x00, 0x00,
+      0x00, 0x03, 0x03, 0x00, 0x01),
+
+   GSCR_CMD(GCTRL_SETCYC, 0x00, 0x18, 0x80, 0x10, 0x01), //SETCYC
+
+   GSCR_CMD(GCTRL_SETVCOM, 0x2C, 0x2C), //SETVCOM
+
+   GSCR_CMD(0xD5, //SETGIP  (
+      0x00, 0x05, 0x03, 0x00, 0x01, 0x09, 0x10, 0x80,
+      0x37, 0x37, 0x20, 0x31, 0x46, 0x8A, 0x57, 0x9B,
+      0x20, 0x31, 0x46, 0x8A, 0x57, 0x9B, 0x07, 0x0F,
+      0x02, 0x00),
+
+   GSCR_CMD(GCTRL_COLMOD, COLMOD_VAL), //COLMOD
+
+   GSCR_CMD(GCTRL_MADCTRL, //MADCTL
+      (MY_BIT|MX_BIT|MV_BIT|RGB_BIT)), /* MY,MX,MV,ML,BGR,0,0,0 */
+
+   GSCR_CMD0_WAIT(GCTRL_SLPOUT,1000), //SLPOUT
    /* LUT initialization required for 16 and 18 bit pr pixel mode is initializaed via a software loop */
-   {CMD,0,0x0}   // Nop
+   GSCR_CMD0(0x0), // Nop
+   GSCR_END
    };
 
 #endif
 
+#ifdef GHW_WRITE_COMBINE
+/* Write combining state, see ghw_set_xyrange() */
+#define GHW_WC_CLOSED 0   /* No RAMWR stream open */
+#define GHW_WC_OPEN   1   /* RAMWR stream open, pixel data can be appended */
+#define GHW_WC_PAUSED 2   /* Stream paused by ghw_auto_wr_end(), resume with RAMWRC */
+static SGUCHAR ghw_wc_state;
+static SGUCHAR ghw_wc_combined;  /* Last ghw_set_xyrange() was appended to the stream */
+static GXT ghw_wc_xb, ghw_wc_xe; /* Programmed window */
+static GYT ghw_wc_yb, ghw_wc_ye;
+static GXT ghw_wc_rxb, ghw_wc_rxe; /* Requested window, when combined */
+static GYT ghw_wc_ryb, ghw_wc_rye;
+static GBUFINT ghw_wc_cnt;       /* Pixels written since the window was programmed */
+#endif
+
 /*
    Send a command
 */
 static void ghw_cmd(SGUCHAR cmd)
    {
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_state = GHW_WC_CLOSED; /* Any command ends the RAMWR stream */
+   #endif
    #ifndef GHW_NOHDW
    #ifdef GHW_BUS8
    sgwrby(GHWCMD,cmd);    /* Register */
@@ -1433,6 +1342,79 @@ static void ghw_cmddat(SGUCHAR dat)
 
 #endif
 
+/*
+   Execute one init script entry, including any continuation entries,
+   and advance *script to the next entry.
+   The script format is described in ghwscript.h
+
+   Returns the wait requested by the entry in ms (0 = no wait)
+   Returns GSCR_DONE at the end of the script
+*/
+SGUINT ghw_script_step(GCODE SGUCHAR **script)
+   {
+   GCODE SGUCHAR *p;  /* Read via GSCR_RD() only */
+   SGUCHAR ctl,n;
+   SGUINT wait;
+   #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || defined( GHW_HX8352B ) || defined( GHW_HX8325_REGINTF ))
+   SGUCHAR index = 0;
+   #elif (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+   SGUCHAR buf[16];
+   SGUCHAR i;
+   #endif
+
+   p = *script;
+   if ((ctl = GSCR_RD(p++)) == GSCR_END)
+      return GSCR_DONE;
+
+   #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || defined( GHW_HX8352B ) || defined( GHW_HX8325_REGINTF ))
+   if ((ctl & GSCR_DATFLAG) == 0)
+      index = GSCR_RD(p++);
+   #else
+   if ((ctl & GSCR_DATFLAG) == 0)
+      ghw_cmd(GSCR_RD(p++));
+   #endif
+
+   for(;;)
+      {
+      n = ctl & GSCR_NARGMSK;
+      #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || defined( GHW_HX8352B ) || defined( GHW_HX8325_REGINTF ))
+      /* Register mode, each argument is written to the register */
+      while (n-- != 0)
+         ghw_cmd_wr(index, GSCR_RD(p++));
+      #elif (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+      /* Append the parameters to the data burst */
+      while (n != 0)
+         {
+         for (i = 0; (i < sizeof(buf)) && (i < n); i++)
+            buf[i] = GSCR_RD(p++);
+         GHW_TR->write_burst(buf, i);
+         n -= i;
+         }
+      #else
+      while (n-- != 0)
+         ghw_cmddat(GSCR_RD(p++));
+      #endif
+
+      if ((ctl & GSCR_WAITFLAG) != 0)
+         {
+         wait = ((SGUINT) GSCR_RD(p++)) * 5;
+         break;
+         }
+      if (((GSCR_RD(p) & GSCR_DATFLAG) == 0) || (GSCR_RD(p) == GSCR_END))
+         {
+         wait = 0;
+         break;
+         }
+      ctl = GSCR_RD(p++);  /* Continuation entry */
+      }
+
+   *script = p;
+   #if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+   GHW_TR->flush(); /* Release the bus */
+   #endif
+   return wait;
+   }
+
 #if (defined(GBUFFER) || !defined( GHW_NO_LCD_READ_SUPPORT ))
 
 /* Make a single data read operation */
@@ -1451,6 +1433,23 @@ static SGUCHAR ghw_rddat( void )
    #endif
    }
 
+/*
+   Send a command which is followed by read data (RAMRD).
+   On the serial transports CS must be kept low from the command into
+   the read data, else the controller ends the read command.
+*/
+static void ghw_cmd_rd(SGUCHAR cmd)
+   {
+   #if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_state = GHW_WC_CLOSED; /* Any command ends the RAMWR stream */
+   #endif
+   GHW_TR->read_cmd(cmd);
+   #else
+   ghw_cmd(cmd);
+   #endif
+   }
+
 #endif
 
 /*
@@ -1462,11 +1461,340 @@ static SGUCHAR ghw_rddat( void )
 #if (( defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ) && ((GDISPPIXW == 18)||(GDISPPIXW == 24)))
 static SGUCHAR ghw_word_is_started;
 #endif
+
+#ifdef GHW_WINDOW_CACHE
+/*
+   Last column and row range programmed with CASET / RASET.
+   ghw_set_xyrange() only sends the half which differs from the cache.
+*/
+#define GHW_WIN_COL 0x01
+#define GHW_WIN_ROW 0x02
+static SGUCHAR ghw_win_valid;
+static GXT ghw_win_xb, ghw_win_xe;
+static GYT ghw_win_yb, ghw_win_ye;
+
+/*
+   Forget the cached window. Must be called whenever the controller
+   window registers may have been changed outside ghw_set_xyrange()
+   (init, reset, sleep, direct controller access)
+*/
+void ghw_win_invalidate(void)
+   {
+   ghw_win_valid = 0;
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_state = GHW_WC_CLOSED;
+   #endif
+   }
+#endif
+
+#ifdef GHW_WRITE_COMBINE
+#if (!defined( GCTRL_RAMWRC ) || !defined( GHW_USE_TRANSPORT ))
+  #error GHW_WRITE_COMBINE requires a command mode controller with RAMWRC and GHW_USE_TRANSPORT
+#endif
+/*
+   Check if a write to the window xb,yb,xe,ye can be appended to the open
+   RAMWR stream. This is the case when the controller address counter is
+   at xb,yb and the write wraps the same way in the programmed window
+   (same columns, or a single row segment ending inside the window).
+   A paused stream is resumed with RAMWRC.
+   Return 1 if the write is appended (no window setting needed)
+*/
+static SGUCHAR ghw_wc_continues(GXT xb, GYT yb, GXT xe, GYT ye)
+   {
+   GBUFINT w,px,py;
+   if (ghw_wc_state == GHW_WC_CLOSED)
+      return 0;
+
+   /* Current address counter position */
+   w = (GBUFINT)(ghw_wc_xe - ghw_wc_xb) + 1;
+   if (ghw_wc_cnt < w)
+      {
+      px = ghw_wc_xb + ghw_wc_cnt;  /* Avoid division in the common case */
+      py = ghw_wc_yb;
+      }
+   else
+      {
+      px = ghw_wc_xb + (ghw_wc_cnt % w);
+      py = ghw_wc_yb + (ghw_wc_cnt / w);
+      }
+   if ((px != (GBUFINT) xb) || (py != (GBUFINT) yb) || (py > (GBUFINT) ghw_wc_ye))
+      return 0;
+
+   if (yb == ye)
+      {
+      if (xe > ghw_wc_xe)
+         return 0;  /* Row segment would wrap early */
+      }
+   else
+   if ((xb != ghw_wc_xb) || (xe != ghw_wc_xe) || (ye > ghw_wc_ye))
+      return 0;
+
+   if (ghw_wc_state == GHW_WC_PAUSED)
+      ghw_cmd(GCTRL_RAMWRC);  /* Continue at address counter */
+   ghw_wc_state = GHW_WC_OPEN;
+   ghw_wc_combined = 1;
+   ghw_wc_rxb = xb;
+   ghw_wc_ryb = yb;
+   ghw_wc_rxe = xe;
+   ghw_wc_rye = ye;
+   return 1;
+   }
+
+/*
+   Flush point for write combining, used by ghw_auto_wr_end().
+   The transport burst is completed, the stream is only paused so a
+   following write at the address counter can continue with RAMWRC.
+*/
+void ghw_wc_flush(void)
+   {
+   GHW_TR->flush();
+   if (ghw_wc_state == GHW_WC_OPEN)
+      ghw_wc_state = GHW_WC_PAUSED;
+   }
+#endif
+
+#ifdef GHW_HW_SCROLL
+#ifndef GHW_HX8357D
+  #error GHW_HW_SCROLL is only supported for GHW_HX8357D
+#endif
+#define GHW_VS_ROWS 480   /* GRAM rows */
+
+/*
+   Hardware vertical scroll (ghw_vscroll()).
+
+   The rows ghw_vs_top - ghw_vs_bot are the controller scroll area. When
+   the area has been scrolled ghw_vs_ofs rows, logical row y in the area
+   is kept in GRAM row top + ((y - top + ofs) mod rows), so the rest of the
+   driver can continue to use logical coordinates.
+
+   ghw_set_xyrange() translates the window rows. If the logical rows are
+   not one GRAM row sequence the window is split in segments, and the
+   next segment is programmed by ghw_auto_wr() / ghw_auto_rd() when the
+   pixels of the current segment are used.
+*/
+static SGUCHAR ghw_vs_def;           /* Scroll area defined */
+static GYT ghw_vs_top, ghw_vs_bot;   /* Scroll area (logical rows) */
+static GYT ghw_vs_ofs;               /* Rows scrolled, 0 = linear */
+
+static SGUCHAR ghw_vs_nseg;          /* Segments left after the current */
+static SGUCHAR ghw_vs_seg;           /* Index of next segment */
+static SGUCHAR ghw_vs_rd;            /* Window is used for read back */
+static GYT ghw_vs_sy[3];             /* First logical row of each following segment */
+static GYT ghw_vs_ye;                /* Last logical row of window */
+static GXT ghw_vs_w;                 /* Window width */
+static GBUFINT ghw_vs_left;          /* Pixels left in current segment */
+
+/* Logical row to GRAM row (before mirroring) */
+static GYT ghw_vs_map(GYT y)
+   {
+   if ((ghw_vs_ofs == 0) || (y < ghw_vs_top) || (y > ghw_vs_bot))
+      return y;
+   y = (GYT)(y + ghw_vs_ofs);
+   if (y > ghw_vs_bot)
+      y = (GYT)(y - (ghw_vs_bot - ghw_vs_top + 1));
+   return y;
+   }
+
+/*
+   Prepare the segments for the window xb,yb,xe,ye and translate yb,ye
+   to the rows of the first segment
+*/
+static void ghw_vs_window(GXT xb, GXT xe, GYT *yb, GYT *ye)
+   {
+   GYT brk[3];
+   SGUCHAR i;
+   ghw_vs_nseg = 0;
+   ghw_vs_seg = 0;
+   ghw_vs_rd = 0;
+   if ((ghw_vs_ofs == 0) || (*ye < ghw_vs_top) || (*yb > ghw_vs_bot))
+      return;
+
+   /* Logical rows where the GRAM row sequence breaks */
+   brk[0] = ghw_vs_top;
+   brk[1] = (GYT)(ghw_vs_bot - ghw_vs_ofs + 1);  /* Row stored at the area top */
+   brk[2] = (GYT)(ghw_vs_bot + 1);
+   for (i = 0; i < 3; i++)
+      {
+      if ((brk[i] > *yb) && (brk[i] <= *ye))
+         ghw_vs_sy[ghw_vs_nseg++] = brk[i];
+      }
+
+   ghw_vs_w = (GXT)(xe - xb + 1);
+   ghw_vs_ye = *ye;
+   if (ghw_vs_nseg != 0)
+      {
+      *ye = (GYT)(ghw_vs_sy[0] - 1);
+      ghw_vs_left = (GBUFINT)(*ye - *yb + 1) * ghw_vs_w;
+      }
+   *yb = ghw_vs_map(*yb);
+   *ye = ghw_vs_map(*ye);
+   }
+
+/*
+   Program the next window segment
+*/
+static void ghw_vs_next(void)
+   {
+   GYT yb,ye;
+   yb = ghw_vs_sy[ghw_vs_seg++];
+   ye = (--ghw_vs_nseg != 0) ? (GYT)(ghw_vs_sy[ghw_vs_seg] - 1) : ghw_vs_ye;
+   ghw_vs_left = (GBUFINT)(ye - yb + 1) * ghw_vs_w;
+   yb = ghw_vs_map(yb);
+   ye = ghw_vs_map(ye);
+
+   ghw_cmd(GCTRL_RASET);
+   ghw_cmddat((SGUCHAR)(((SGUINT) (yb+G_YOFFSET)) >> 8));
+   ghw_cmddat((SGUCHAR) (yb+G_YOFFSET));
+   ghw_cmddat((SGUCHAR)(((SGUINT) (ye+G_YOFFSET)) >> 8));
+   ghw_cmddat((SGUCHAR) (ye+G_YOFFSET));
+   #ifdef GHW_WINDOW_CACHE
+   ghw_win_yb = yb;
+   ghw_win_ye = ye;
+   #endif
+   #if (defined(GBUFFER) || !defined( GHW_NO_LCD_READ_SUPPORT ))
+   if (ghw_vs_rd)
+      {
+      GHW_STATS_INC(rd_turn);
+      ghw_cmd_rd(GCTRL_RAMRD);
+      ghw_rddat(); /* Dummy read */
+      return;
+      }
+   #endif
+   ghw_cmd(GCTRL_RAMWR);
+   }
+
+/*
+   Forget the scroll state. The scroll registers are at reset defaults
+*/
+static void ghw_vs_reset(void)
+   {
+   ghw_vs_def = 0;
+   ghw_vs_ofs = 0;
+   ghw_vs_nseg = 0;
+   }
+
+/* First GRAM row of the area lty - rby */
+static SGUINT ghw_vs_tfa(GYT lty, GYT rby)
+   {
+   #ifdef GHW_MIRROR_VER
+   return (SGUINT)(GHW_VS_ROWS - 1 - (rby + G_YOFFSET));
+   #else
+   return (SGUINT)(lty + G_YOFFSET);
+   #endif
+   }
+
+/*
+   Scroll the full width rows lty - rby lines up with the controller
+   vertical scroll. The area is defined with VSCRDEF when the scroll
+   starts, after that each scroll step is a VSCRSADD command.
+   The lines exposed at the bottom are not cleared.
+   Returns 0 if done, or 1 if the area cannot be hardware scrolled now
+   (another area is in a scrolled state, or the display is rotated so the
+   GRAM rows are display columns)
+*/
+SGUCHAR ghw_vscroll(GYT lty, GYT rby, GYT lines)
+   {
+   GYT rows = (GYT)(rby - lty + 1);
+   SGUINT tfa,vsp;
+
+   if (MV_BIT != 0)
+      return 1;
+   if ((rby < lty) || (lines >= rows))
+      return 1;
+   if (!ghw_vs_def || (lty != ghw_vs_top) || (rby != ghw_vs_bot))
+      {
+      if (ghw_vs_ofs != 0)
+         return 1;
+      ghw_vs_top = lty;
+      ghw_vs_bot = rby;
+      ghw_vs_def = 0;
+      }
+
+   tfa = ghw_vs_tfa(lty, rby);
+
+   if (!ghw_vs_def)
+      {
+      ghw_cmd(GCTRL_VSCRDEF);
+      ghw_cmddat((SGUCHAR)(tfa >> 8));
+      ghw_cmddat((SGUCHAR) tfa);
+      ghw_cmddat((SGUCHAR)(rows >> 8));
+      ghw_cmddat((SGUCHAR) rows);
+      ghw_cmddat((SGUCHAR)((GHW_VS_ROWS - tfa - rows) >> 8));
+      ghw_cmddat((SGUCHAR) (GHW_VS_ROWS - tfa - rows));
+      ghw_vs_def = 1;
+      }
+
+   ghw_vs_ofs = (GYT)(ghw_vs_ofs + lines);
+   if (ghw_vs_ofs >= rows)
+      ghw_vs_ofs = (GYT)(ghw_vs_ofs - rows);
+
+   /* First scanned area line shows the GRAM row of logical row lty */
+   #ifdef GHW_MIRROR_VER
+   vsp = tfa + ((ghw_vs_ofs == 0) ? 0 : (rows - ghw_vs_ofs));
+   #else
+   vsp = tfa + ghw_vs_ofs;
+   #endif
+   ghw_cmd(GCTRL_VSCRSADD);
+   ghw_cmddat((SGUCHAR)(vsp >> 8));
+   ghw_cmddat((SGUCHAR) vsp);
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_state = GHW_WC_CLOSED;  /* Logical rows have moved */
+   #endif
+   ghw_auto_wr_end();
+   return 0;
+   }
+
+/*
+   The full width rows lty - rby are about to be overwritten. If they
+   cover the scrolled area the rows are mapped linear again, so another
+   area can be hardware scrolled later (ex after a screen clear)
+*/
+void ghw_vscroll_cover(GYT lty, GYT rby)
+   {
+   SGUINT tfa;
+   if ((ghw_vs_ofs == 0) || (lty > ghw_vs_top) || (rby < ghw_vs_bot))
+      return;
+   ghw_vs_ofs = 0;
+   tfa = ghw_vs_tfa(ghw_vs_top, ghw_vs_bot);
+   ghw_cmd(GCTRL_VSCRSADD);
+   ghw_cmddat((SGUCHAR)(tfa >> 8));
+   ghw_cmddat((SGUCHAR) tfa);
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_state = GHW_WC_CLOSED;  /* Logical rows have moved */
+   #endif
+   ghw_auto_wr_end();
+   }
+#endif /* GHW_HW_SCROLL */
+
 void ghw_set_xyrange(GXT xb, GYT yb, GXT xe, GYT ye)
    {
+   #ifdef GHW_HW_SCROLL
+   GYT lyb = yb;  /* Logical rows, yb, ye are translated to GRAM rows */
+   GYT lye = ye;
+   #endif
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_state == GHW_BAND_DRAW)
+      {
+      ghw_band_xyrange(xb, yb, xe, ye);  /* Replay into the band buffer */
+      return;
+      }
+   #endif
    #ifdef GHW_PCSIM
    ghw_set_xyrange_sim( xb, yb, xe, ye);
    #endif
+   GHW_STATS_INC(windows);
+
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_combined = 0;
+   if (ghw_wc_continues(xb, yb, xe, ye))
+      return;
+   if (yb == ye)
+      xe = GDISPW-1;  /* Open ended row, so following segments on the row can be appended */
+   #endif
+
+   #ifdef GHW_HW_SCROLL
+   ghw_vs_window(xb, xe, &yb, &ye);
+   #endif
 
    #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || \
         defined( GHW_HX8352B ) || defined( GHW_HX8325_REGINTF ))
@@ -1497,29 +1825,70 @@ void ghw_set_xyrange(GXT xb, GYT yb, GXT xe, GYT ye)
    #endif
 
    #elif (defined( GHW_HX8346_CMDINTF ) || defined( GHW_HX8325_CMDINTF )  || \
-          defined( GHW_ILI9163) || defined( GHW_ILI9488) || defined( GHW_HX8369))
+          defined( GHW_ILI9163) || defined( GHW_ILI9488) || defined( GHW_HX8369) || \
+          defined( GHW_HX8357D ))
 
-   ghw_cmd(GCTRL_CASET);
-   ghw_cmddat((SGUCHAR)(((SGUINT) (xb+G_XOFFSET)) >> 8));
-   ghw_cmddat((SGUCHAR) (xb+G_XOFFSET));
-   ghw_cmddat((SGUCHAR)(((SGUINT) (xe+G_XOFFSET)) >> 8));
-   ghw_cmddat((SGUCHAR) (xe+G_XOFFSET));
+   #ifdef GHW_WINDOW_CACHE
+   if (((ghw_win_valid & GHW_WIN_COL) == 0) || (xb != ghw_win_xb) || (xe != ghw_win_xe))
+   #endif
+      {
+      ghw_cmd(GCTRL_CASET);
+      ghw_cmddat((SGUCHAR)(((SGUINT) (xb+G_XOFFSET)) >> 8));
+      ghw_cmddat((SGUCHAR) (xb+G_XOFFSET));
+      ghw_cmddat((SGUCHAR)(((SGUINT) (xe+G_XOFFSET)) >> 8));
+      ghw_cmddat((SGUCHAR) (xe+G_XOFFSET));
+      #ifdef GHW_WINDOW_CACHE
+      ghw_win_xb = xb;
+      ghw_win_xe = xe;
+      ghw_win_valid |= GHW_WIN_COL;
+      #endif
+      }
 
-   ghw_cmd(GCTRL_RASET);
-   ghw_cmddat((SGUCHAR)(((SGUINT) (yb+G_YOFFSET)) >> 8));
-   ghw_cmddat((SGUCHAR) (yb+G_YOFFSET));
-   ghw_cmddat((SGUCHAR)(((SGUINT) (ye+G_YOFFSET)) >> 8));
-   ghw_cmddat((SGUCHAR) (ye+G_YOFFSET));
+   #ifdef GHW_WINDOW_CACHE
+   if (((ghw_win_valid & GHW_WIN_ROW) == 0) || (yb != ghw_win_yb) || (ye != ghw_win_ye))
+   #endif
+      {
+      ghw_cmd(GCTRL_RASET);
+      ghw_cmddat((SGUCHAR)(((SGUINT) (yb+G_YOFFSET)) >> 8));
+      ghw_cmddat((SGUCHAR) (yb+G_YOFFSET));
+      ghw_cmddat((SGUCHAR)(((SGUINT) (ye+G_YOFFSET)) >> 8));
+      ghw_cmddat((SGUCHAR) (ye+G_YOFFSET));
+      #ifdef GHW_WINDOW_CACHE
+      ghw_win_yb = yb;
+      ghw_win_ye = ye;
+      ghw_win_valid |= GHW_WIN_ROW;
+      #endif
+      }
 
    #elif  defined( GHW_SSD1355 ) || defined( GHW_ST7628 )
 
-   ghw_cmd(GCTRL_CASET);
-   ghw_cmddat((SGUCHAR) (xb+G_XOFFSET));
-   ghw_cmddat((SGUCHAR) (xe+G_XOFFSET));
+   #ifdef GHW_WINDOW_CACHE
+   if (((ghw_win_valid & GHW_WIN_COL) == 0) || (xb != ghw_win_xb) || (xe != ghw_win_xe))
+   #endif
+      {
+      ghw_cmd(GCTRL_CASET);
+      ghw_cmddat((SGUCHAR) (xb+G_XOFFSET));
+      ghw_cmddat((SGUCHAR) (xe+G_XOFFSET));
+      #ifdef GHW_WINDOW_CACHE
+      ghw_win_xb = xb;
+      ghw_win_xe = xe;
+      ghw_win_valid |= GHW_WIN_COL;
+      #endif
+      }
 
-   ghw_cmd(GCTRL_RASET);
-   ghw_cmddat((SGUCHAR) (yb+G_YOFFSET));
-   ghw_cmddat((SGUCHAR) (ye+G_YOFFSET));
+   #ifdef GHW_WINDOW_CACHE
+   if (((ghw_win_valid & GHW_WIN_ROW) == 0) || (yb != ghw_win_yb) || (ye != ghw_win_ye))
+   #endif
+      {
+      ghw_cmd(GCTRL_RASET);
+      ghw_cmddat((SGUCHAR) (yb+G_YOFFSET));
+      ghw_cmddat((SGUCHAR) (ye+G_YOFFSET));
+      #ifdef GHW_WINDOW_CACHE
+      ghw_win_yb = yb;
+      ghw_win_ye = ye;
+      ghw_win_valid |= GHW_WIN_ROW;
+      #endif
+      }
 
    #endif
 
@@ -1527,6 +1896,22 @@ void ghw_set_xyrange(GXT xb, GYT yb, GXT xe, GYT ye)
    #if (( defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ) && ((GDISPPIXW == 18)||(GDISPPIXW == 24)))
    ghw_word_is_started = 0;
    #endif
+   #ifdef GHW_WRITE_COMBINE
+   #ifdef GHW_HW_SCROLL
+   yb = lyb;
+   ye = lye;
+   #endif
+   ghw_wc_xb = xb;
+   ghw_wc_yb = yb;
+   ghw_wc_xe = xe;
+   ghw_wc_ye = ye;
+   ghw_wc_cnt = 0;
+   ghw_wc_state = GHW_WC_OPEN;
+   #ifdef GHW_HW_SCROLL
+   if (ghw_vs_nseg != 0)
+      ghw_wc_state = GHW_WC_CLOSED; /* Split window, the stream cannot be continued */
+   #endif
+   #endif
 
 
    }
@@ -1568,9 +1953,28 @@ void _ghw_auto_wr_end(void)
 */
 void ghw_auto_wr(GCOLOR dat)
    {
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_state == GHW_BAND_DRAW)
+      {
+      ghw_band_wr(dat);
+      return;
+      }
+   #endif
    #ifdef GHW_PCSIM
    ghw_autowr_sim( dat );
    #endif
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_cnt++;
+   #endif
+   #ifdef GHW_HW_SCROLL
+   if (ghw_vs_nseg != 0)
+      {
+      if (ghw_vs_left == 0)
+         ghw_vs_next();
+      ghw_vs_left--;
+      }
+   #endif
+   GHW_STATS_INC(pix_wr);
 
    #ifndef GHW_NOHDW
 
@@ -1616,7 +2020,8 @@ void ghw_auto_wr(GCOLOR dat)
    #elif (defined( GHW_BUS8 ) && (GDISPPIXW == 16))
     #if defined( GHW_ST7628  ) || defined( GHW_HX8347G ) || \
         defined( GHW_HX8352B ) || defined( GHW_HX8353D_CMDINTF) || \
-        defined( GHW_SSD1355 ) || defined( GHW_ILI9163 ) || defined( GHW_HX8369 ) ||  defined(GHW_ILI9488)
+        defined( GHW_SSD1355 ) || defined( GHW_ILI9163 ) || defined( GHW_HX8369 ) ||  defined(GHW_ILI9488) || \
+        defined( GHW_HX8357D )
       sgwrby(GHWWR, (SGUCHAR)(dat>>8));
       sgwrby(GHWWR, (SGUCHAR)(dat));     /* LSB */
     #else
@@ -1659,8 +2064,100 @@ void ghw_auto_wr(GCOLOR dat)
    #endif
 
    #endif
-   #endif /* GHW_NOHDW */
+   #endif /* GHW_NOHDW */
+   }
+
+/*
+   Write the same color count times (at current position).
+   Used by all uniform color fills. With a display transport the
+   color is split once and streamed by the transport repeat loop.
+
+   Internal ghw function
+*/
+void ghw_auto_wr_repeat(GCOLOR dat, GBUFINT count)
+   {
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_state == GHW_BAND_DRAW)
+      {
+      ghw_band_wr_repeat(dat, count);
+      return;
+      }
+   #endif
+   #if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ) && (GDISPPIXW == 16))
+   #ifdef GHW_PCSIM
+   GBUFINT i;
+   for (i = 0; i < count; i++)
+      ghw_autowr_sim( dat );
+   #endif
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_cnt += count;
+   #endif
+   GHW_STATS_ADD(pix_wr, count);
+   #ifdef GHW_HW_SCROLL
+   while ((ghw_vs_nseg != 0) && (count != 0))
+      {
+      /* Split window, write the segments one by one */
+      GBUFINT n;
+      if (ghw_vs_left == 0)
+         ghw_vs_next();
+      n = (count < ghw_vs_left) ? count : ghw_vs_left;
+      GHW_TR->write_repeat((SGUCHAR)(dat>>8), (SGUCHAR)(dat), (SGULONG) n);
+      ghw_vs_left -= n;
+      count -= n;
+      }
+   #endif
+   if (count != 0)
+      GHW_TR->write_repeat((SGUCHAR)(dat>>8), (SGUCHAR)(dat), (SGULONG) count);
+   #else
+   while (count-- != 0)
+      ghw_auto_wr(dat);
+   #endif
+   }
+
+#ifdef GHW_BAND_ROWS
+/*
+   Write count pixels from buf (2 bytes pr pixel, msb first) at the
+   current position. With a display transport the buffer is sent as
+   one burst.
+
+   Internal ghw function
+*/
+void ghw_auto_wr_burst(const SGUCHAR *buf, GBUFINT count)
+   {
+   #if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ) && defined( GHW_BUS8 ))
+   GBUFINT n;
+   #ifdef GHW_PCSIM
+   for (n = 0; n < count; n++)
+      ghw_autowr_sim( (GCOLOR)((((GCOLOR) buf[2*n]) << 8) | buf[2*n+1]) );
+   #endif
+   #ifdef GHW_WRITE_COMBINE
+   ghw_wc_cnt += count;
+   #endif
+   GHW_STATS_ADD(pix_wr, count);
+   while (count != 0)
+      {
+      n = (count > 0x7fff) ? 0x7fff : count;   /* Transport burst length is 16 bit */
+      #ifdef GHW_HW_SCROLL
+      if (ghw_vs_nseg != 0)
+         {
+         /* Split window, write the segments one by one */
+         if (ghw_vs_left == 0)
+            ghw_vs_next();
+         if (n > ghw_vs_left)
+            n = ghw_vs_left;
+         ghw_vs_left -= n;
+         }
+      #endif
+      GHW_TR->write_burst(buf, (uint16_t)(n*2));
+      buf += n*2;
+      count -= n;
+      }
+   #else
+   for (; count != 0; count--, buf += 2)
+      ghw_auto_wr((GCOLOR)((((GCOLOR) buf[0]) << 8) | buf[1]));
+   #endif
    }
+#endif
 
 #if (defined(GBUFFER) || !defined( GHW_NO_LCD_READ_SUPPORT ))
 /*
@@ -1670,13 +2167,36 @@ void ghw_auto_wr(GCOLOR dat)
 
    Note HX8352 (etc) in 16 bit pr pixel mode only support read of 2 pixels using 3 words
    we must keep track on the read pixel order
+
+   Note HX8357D on the 8 bit bus and on SPI returns a dummy byte (8 dummy
+   clocks) after RAMRD, and then 3 bytes (R,G,B 6 bit left aligned) pr pixel
+   also in 16 bit pr pixel mode.
 */
 #if ((defined( GHW_HX8352B ) || defined( GHW_ILI9341V ) || defined( GHW_HX8347G ) || defined( GHW_HX8353D_CMDINTF ) || defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ))
 static SGUCHAR ghw_word_is_ready;
 #endif
 void ghw_auto_rd_start(void)
    {
-   ghw_cmd(GCTRL_RAMRD);
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_state == GHW_BAND_DRAW)
+      return;   /* Read from the band buffer */
+   #endif
+   #ifdef GHW_WRITE_COMBINE
+   if (ghw_wc_combined)
+      {
+      /* RAMRD starts at the window origin, program the requested window */
+      ghw_wc_state = GHW_WC_CLOSED;
+      ghw_set_xyrange(ghw_wc_rxb, ghw_wc_ryb, ghw_wc_rxe, ghw_wc_rye);
+      }
+   #endif
+   #ifdef GHW_WINDOW_CACHE
+   ghw_win_invalidate();  /* Do not trust the window across a read back */
+   #endif
+   #ifdef GHW_HW_SCROLL
+   ghw_vs_rd = 1;  /* Following segments are read */
+   #endif
+   GHW_STATS_INC(rd_turn);
+   ghw_cmd_rd(GCTRL_RAMRD);
    ghw_rddat(); /* Single dummy read operation */
    #if ((defined( GHW_HX8352B ) || defined( GHW_ILI9341V ) || defined( GHW_HX8347G ) || defined( GHW_HX8353D_CMDINTF ) || defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ))
    ghw_word_is_ready = 0;
@@ -1688,6 +2208,19 @@ void ghw_auto_rd_start(void)
 */
 GCOLOR ghw_auto_rd(void)
    {
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_state == GHW_BAND_DRAW)
+      return ghw_band_rd();
+   #endif
+   #ifdef GHW_HW_SCROLL
+   if (ghw_vs_nseg != 0)
+      {
+      if (ghw_vs_left == 0)
+         ghw_vs_next();
+      ghw_vs_left--;
+      }
+   #endif
+   GHW_STATS_INC(pix_rd);
    #ifndef GHW_NOHDW
    #if ((defined( GHW_HX8352B ) || defined( GHW_ILI9341V ) || defined( GHW_HX8347G ) || defined( GHW_HX8353D_CMDINTF ) || defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ))
       /* Only support read of two 18 (24) bit pixels arranged in 3x16-bit words-> must keep track
@@ -1797,6 +2330,113 @@ GCOLOR ghw_auto_rd(void)
    #endif /* GHW_NOHDW */
    }
 
+#if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ) && defined( GHW_BUS8 ) && (GDISPPIXW == 16) && !defined( GHW_ST7628 ))
+   #define GHW_RD_BLOCK  /* Pixel read in transport bursts */
+   #ifndef GHW_RD_BURST
+      #define GHW_RD_BURST 8  /* Pixels pr transport read burst (3 bytes each) */
+   #endif
+#endif
+
+/*
+   Read n pixels at the address set by ghw_auto_rd_start(), same as
+   n ghw_auto_rd() calls.
+   On the 8 bit bus and SPI the controller returns each pixel as 3 bytes
+   (R,G,B 6 bit left aligned) which is converted to RGB565 here. The bytes
+   are fetched with transport read bursts instead of a call pr byte.
+*/
+void ghw_auto_rd_block(GCOLOR *buf, SGUINT n)
+   {
+   #ifdef GHW_RD_BLOCK
+   SGUCHAR rb[3*GHW_RD_BURST];
+   SGUCHAR *bp;
+   SGUINT i;
+   #ifdef GHW_HW_SCROLL
+   if (ghw_vs_nseg != 0)
+      {
+      /* Window is split, let ghw_auto_rd() follow the segments */
+      while (n-- != 0)
+         *buf++ = ghw_auto_rd();
+      return;
+      }
+   #endif
+   GHW_STATS_ADD(pix_rd, n);
+   while (n != 0)
+      {
+      i = (n > GHW_RD_BURST) ? GHW_RD_BURST : n;
+      n -= i;
+      GHW_TR->read_burst(&rb[0], (uint16_t)(3*i));
+      for (bp = &rb[0]; i != 0; i--, bp += 3)
+         *buf++ = (GCOLOR)((((GCOLOR)(bp[0] & 0xf8)) << 8) |   /* (RRRRR*** ********) */
+                           (((GCOLOR)(bp[1] & 0xfc)) << 3) |   /* (*****GGG GGG*****) */
+                           ((GCOLOR)(bp[2] >> 3)));            /* (******** ***BBBBB) */
+      }
+   #else
+   while (n-- != 0)
+      *buf++ = ghw_auto_rd();
+   #endif
+   }
+
+#ifndef GBUFFER
+/*
+   Chunked read-modify-write (ghw_gscroll, ghw_invert)
+
+   Pixels xb..xe in row ys are read, modified by op (if not NULL) and
+   written to row yd. The row is processed GHW_RMW_CHUNK pixels at a time
+   with the read and write windows set pr chunk, so only a chunk buffer is
+   needed instead of a full display row. Each chunk costs two window
+   settings and a RAMRD turn-around, see GHW_RMW_CHUNK in gdispcfg.h.
+*/
+#ifndef GHW_RMW_CHUNK
+  #define GHW_RMW_CHUNK 64
+#endif
+#if (GHW_RMW_CHUNK < 1)
+  #error GHW_RMW_CHUNK must be at least 1
+#endif
+#if (GHW_RMW_CHUNK > GDISPW)
+  #undef  GHW_RMW_CHUNK
+  #define GHW_RMW_CHUNK GDISPW
+#endif
+
+static GCOLOR ghw_rmwbuf[GHW_RMW_CHUNK]; /* Chunk buffer */
+
+void ghw_rmw_row(GXT xb, GXT xe, GYT ys, GYT yd, GHW_RMW_OP op)
+   {
+   GXT xc;
+   SGUINT i,n;
+   for(;;)
+      {
+      n = (SGUINT)(xe - xb) + 1;
+      if (n > GHW_RMW_CHUNK)
+         n = GHW_RMW_CHUNK;
+      xc = (GXT)(xb + (n-1));
+
+      /* Read chunk */
+      #ifdef GHW_NO_RDINC
+      ghw_set_xyrange(xb,ys,xc,ys);
+      for (i = 0; i < n; i++)
+         ghw_rmwbuf[i] = ghw_rd((GXT)(xb+i),ys);
+      #else
+      ghw_set_xyrange(xb,ys,xc,ys);
+      ghw_auto_rd_start();
+      ghw_auto_rd_block(&ghw_rmwbuf[0], n);
+      #endif
+
+      if (op != NULL)
+         op(&ghw_rmwbuf[0], n);
+
+      /* Write chunk */
+      ghw_set_xyrange(xb,yd,xc,yd);
+      for (i = 0; i < n; i++)
+         ghw_auto_wr(ghw_rmwbuf[i]);
+      ghw_auto_wr_end();
+
+      if (xc >= xe)
+         break;
+      xb = (GXT)(xc+1);
+      }
+   }
+#endif /* GBUFFER */
+
 #endif /* GBUFFER || !GHW_NO_LCD_READ_SUPPORT */
 
 
@@ -1865,39 +2505,95 @@ SGBOOL ghw_palette_wr(SGUINT start_index, SGUINT num_elements, GCONSTP GPALETTE_
       /* ghw_palette_opr[start_index++] = ghw_rgb_to_color(&palette++); */
       }
 
+   #if (defined( GBUFFER ) && defined( GHW_INDEXED_BUF ))
+   ghw_ibuf_palette();  /* Buffer colors changed */
+   #endif
+
    return glcd_err;
    }
 #endif
 
 /*
-   Fast set or clear of LCD module RAM buffer
+   Fast set or clear of rows in LCD module RAM buffer
    Internal ghw function
 */
-static void ghw_bufset(GCOLOR color)
+static void ghw_bufset(GCOLOR color, GYT y, GYT rows)
    {
-   GBUFINT cnt;
-   cnt = 0;
-   ghw_set_xyrange(0,0,GDISPW-1,GDISPH-1);
+   #ifdef GBUFFER
+   #if (defined( GHW_INDEXED_BUF ) && defined( GHW_XMEM_BUF ))
+   GYT ys;
+   for (ys = y; ys < y+rows; ys++)
+      ghw_ibuf_fill(GINDEX(0,ys), GDISPW, color);  /* Set ram buffer as well, row by row */
+   #elif defined( GHW_XMEM_BUF )
+   GYT ys;
+   GXT x;
+   GCOLOR *cp;
+   for (ys = y; ys < y+rows; ys++)
+      {
+      /* Set ram buffer as well, a row is contiguous in a bank */
+      cp = GBUF_PTR(GINDEX(0,ys));
+      for (x = 0; x < GDISPW; x++)
+         *cp++ = color;
+      }
+   #else
+   GBUFINT cnt,end;
+   cnt = ((GBUFINT) y) * ((GBUFINT) GDISPW);
+   end = cnt + ((GBUFINT) rows) * ((GBUFINT) GDISPW);
+   #ifdef GHW_INDEXED_BUF
+   ghw_ibuf_fill(cnt, end-cnt, color);  /* Set ram buffer as well */
+   #else
    do
       {
-      /* Clear using X,Y autoincrement */
-      #ifdef GBUFFER
       gbuf[cnt] = color;      /* Set ram buffer as well */
-      #endif
-
-      #if defined( GHW_HX8346_REGINTF )
-      if (color != G_BLACK)   /* hardware buffer is cleared to black by controller at reset
-                                 Only nessesary to clear video buffer here if another color is used */
-         ghw_auto_wr(color);
-      #ifndef GBUFFER
-      else
-          break; /* All clearing done in hardware, skip completely */
-      #endif
-      #else
-      ghw_auto_wr(color);      /* Set LCD buffer */
-      #endif
       }
-   while (++cnt < ((GBUFINT) GDISPW) * ((GBUFINT) GDISPH)); /* Loop until x+y wrap */
+   while (++cnt < end);
+   #endif
+   #endif
+   #endif
+
+   #if defined( GHW_HX8346_REGINTF )
+   if (color == G_BLACK)   /* hardware buffer is cleared to black by controller at reset
+                              Only nessesary to clear video buffer here if another color is used */
+      return;
+   #endif
+
+   #ifdef GHW_ROW_HASH
+   ghw_rowhash_inval();  /* Display written directly */
+   #endif
+
+   /* Clear using X,Y autoincrement */
+   ghw_set_xyrange(0,y,GDISPW-1,(GYT)(y+rows-1));
+   ghw_auto_wr_repeat(color, ((GBUFINT) GDISPW) * ((GBUFINT) rows)); /* Set LCD buffer */
+   ghw_auto_wr_end();
+   }
+
+/*
+   Set the pixels xb..xe in row y to color (display and buffer)
+*/
+static void ghw_bufset_span(GCOLOR color, GXT xb, GXT xe, GYT y)
+   {
+   #ifdef GBUFFER
+   GBUFINT idx = GINDEX(xb,y);
+   #ifdef GHW_INDEXED_BUF
+   ghw_ibuf_fill(idx, (GBUFINT)(xe-xb+1), color);  /* Set ram buffer as well */
+   #else
+   GXT x;
+   for (x = xb; x <= xe; x++)
+      GBUF_WR(idx++, color);   /* Set ram buffer as well */
+   #endif
+   #endif
+
+   #if defined( GHW_HX8346_REGINTF )
+   if (color == G_BLACK)   /* hardware buffer is cleared to black by controller at reset */
+      return;
+   #endif
+
+   #ifdef GHW_ROW_HASH
+   ghw_rowhash_inval();  /* Display written directly */
+   #endif
+
+   ghw_set_xyrange(xb,y,xe,y);
+   ghw_auto_wr_repeat(color, (GBUFINT)(xe-xb+1)); /* Set LCD buffer */
    ghw_auto_wr_end();
    }
 
@@ -2039,113 +2735,73 @@ static void ghw_cmd_wait(SGUCHAR ms)
    }
 
 /*
-   Initialize display, clear ram  (low-level)
-   Clears glcd_err status before init
-
-   Return 0 if no error,
-   Return != 0 if some error
-*/
-SGBOOL ghw_init(void)
-   {
-   short i;
-
-   #ifdef GBUFFER
-   iltx = 1;
-   ilty = 1;
-   irbx = 0;
-   irby = 0;
-   ghw_upddelay = 0;
-   #endif
-
-   glcd_err = 0;
-   ghw_io_init(); /* Set any hardware interface lines, controller hardware reset */
-
-   #if (defined( GHW_ALLOCATE_BUF) && defined( GBUFFER ))
-   if (gbuf == NULL)
-      {
-      /* Allocate graphic ram buffer */
-      if ((gbuf = (GCOLOR *)calloc(ghw_gbufsize(),1)) == NULL)
-         glcd_err = 1;
-      else
-         gbuf_owner = 1;
-      }
-   #endif
-
-   if (glcd_err != 0)
-      return 1;
+   Non-blocking initialization
 
-   #ifdef GHW_PCSIM
-   /* Tell simulator about the visual LCD screen organization */
-   ghw_init_sim( GDISPW, GDISPH );
-   if (glcd_err != 0)
-      return 1;
-   #endif
-   /* Set default colors */
-   ghw_setcolor( GHW_PALETTE_FOREGROUND, GHW_PALETTE_BACKGROUND );
+   The initialization is split in steps which never wait. After each step
+   the number of milli seconds which must elapse before the next step is
+   stored in ghw_init_wait. Elapsed time is counted by ghw_init_tick(),
+   called every 1 ms by the application (ex from a timer interrupt), so the
+   application can initialize other peripherals while the display
+   controller powers up.
 
-   #if (GHW_PALETTE_SIZE > 0)
-   /* Load palette */
-   ghw_palette_wr(0, sizeof(ghw_palette)/sizeof(GPALETTE_RGB), (GCONSTP GPALETTE_RGB PFCODE *)&ghw_palette[0]);
-   #endif
+      ghw_init_start();
+      while (ghw_init_poll())
+         {
+         ... other initialization ...
+         }
+      ginit();   // completes without hardware access
 
-   /*
-      Wait for hardware reset to complete
-      If a delay after reset is already introdued by other parts of the
-      system you may reduce the wait time parameter in the call below or
-      comment out the call
-   */
-   ghw_cmd_wait(150); /* Wait for hardware to stabilize after power on */
+   ghw_init() runs the same steps with a busy wait between them.
+*/
+#define GHW_INIT_IDLE   0  /* No initialization in progress */
+#define GHW_INIT_IO     1  /* Reset and start-up sequence, ghw_io_init_step() */
+#define GHW_INIT_REGS   2  /* Configuration table as1dregs */
+#define GHW_INIT_CLEAR  3  /* Clear display RAM in bands */
+#define GHW_INIT_DISPON 4  /* Display on */
+#define GHW_INIT_DONE   5  /* Completed, result consumed by ghw_init() */
+
+#ifndef GHW_INIT_CLEAR_PIXELS
+  /* Pixels cleared per initialization step (at most). 256 pixels are 512
+     bytes, about 4 ms at the default SPI clock fck/16. Scale with the SPI
+     clock to keep the step time */
+  #define GHW_INIT_CLEAR_PIXELS 256
+#endif
 
-   /*
-   {  // Report ILI9488 status register
-   SGULONG dat = 0;
-   ghw_cmd(0x09); // Read status ID command
-   ghw_rddat();
-
-   dat |= ((SGULONG) ghw_rddat())<<24;
-   dat |= ((SGULONG) ghw_rddat())<<16;
-   dat |= ((SGULONG) ghw_rddat())<<8;
-   dat |= ((SGULONG) ghw_rddat());
-   GPRINTF("\nDisplay status: 0x%lx",dat);
-   }
-   */
+static SGUCHAR ghw_init_state = GHW_INIT_IDLE;
+static GCODE SGUCHAR *ghw_init_scr; /* Next as1dregs entry */
+static SGULONG ghw_init_idx;             /* Next pixel to clear */
+static SGUINT ghw_init_wait;             /* ms to wait before the next step */
+static SGUCHAR ghw_init_tref;            /* ghw_init_ticks at last poll */
+static volatile SGUCHAR ghw_init_ticks;  /* 1 ms counter, 8 bit so it is read atomically */
+static volatile SGUCHAR ghw_init_blocking; /* ghw_init() is busy waiting, ignore the tick */
 
-   /*
-   { // Report ILI9488 Manufacturers ID settings
-   SGUCHAR dat[3];
-   ghw_cmd(0x04); // Read manufacturer ID command
-   dat[0] = ghw_rddat();
-   dat[1] = ghw_rddat();
-   dat[2] = ghw_rddat();
-   GPRINTF("\nDisplay ID1: 0x%02x, ID2: 0x%02x, ID3: 0x%02x, ",
-         (unsigned int)dat[0],
-         (unsigned int)dat[1],
-         (unsigned int)dat[2]);
+/*
+   Called every 1 ms by the application (ex. from a timer interrupt)
+*/
+void ghw_init_tick(void)
+   {
+   if (!ghw_init_blocking)
+      ghw_init_ticks++;
    }
-   */
 
+/*
+   Execute the configuration script until an entry with a delay.
+   Returns the delay.
+*/
+static SGUINT ghw_init_regs_step(void)
+   {
+   SGUINT delay;
+   #if (defined(GHW_HX8369) && ((GDISPPIXW == 18) || (GDISPPIXW == 16)))
+   short i;
+   #endif
 
-   /* Initialize controller according to configuration file */
-   #if (defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || defined( GHW_HX8352B ) ||defined( GHW_HX8325_REGINTF ))
-   /* Register mode */
-   for (i=0; i < sizeof(as1dregs)/sizeof(S1D_REGS); i++)
-      {
-      ghw_cmd_wr(as1dregs[i].index,as1dregs[i].value);
-      if (as1dregs[i].delay != 0)
-         ghw_cmd_wait( as1dregs[i].delay );
-      }
-   #else
-   /* Command mode */
-   for (i=0; i < sizeof(as1dregs)/sizeof(S1D_REGS); i++)
+   while ((delay = ghw_script_step(&ghw_init_scr)) != GSCR_DONE)
       {
-      if (as1dregs[i].index == CMD)
-         ghw_cmd(as1dregs[i].value);
-      else
-         ghw_cmddat(as1dregs[i].value);
-      if (as1dregs[i].delay != 0)
-         ghw_cmd_wait( as1dregs[i].delay );
+      if (delay != 0)
+         return delay;
       }
 
+   #if !(defined( GHW_HX8346_REGINTF ) || defined( GHW_HX8347G ) || defined( GHW_HX8352B ) ||defined( GHW_HX8325_REGINTF ))
    #if (defined(GHW_HX8369) && ((GDISPPIXW == 18) || (GDISPPIXW == 16)))
    /* Special setup */
    /* Set HX8369 5->8 or 6->8 bit color lane lookup table */
@@ -2169,9 +2825,15 @@ SGBOOL ghw_init(void)
    #if ((defined( GHW_HX8369 ) || defined(GHW_ILI9488)) && defined( GHW_BUS16 ) && ((GDISPPIXW == 24) || (GDISPPIXW == 18)))
    ghw_wr_word_is_ready = 0;
    #endif
-
    #endif /* command mode */
 
+   #ifdef GHW_WINDOW_CACHE
+   ghw_win_invalidate();  /* Window registers are at reset defaults */
+   #endif
+   #ifdef GHW_HW_SCROLL
+   ghw_vs_reset();        /* Scroll registers are at reset defaults */
+   #endif
+
    /*
       Stimuli test loops for initial oscilloscope test of display interface bus signals
       Uncomment to use the test loop for the given data bus width.
@@ -2214,25 +2876,202 @@ SGBOOL ghw_init(void)
       (Check the cable or power connections to the display) */
       G_WARNING("Hardware interface error\nCheck display connections\n");  /* Test Warning message output */
       glcd_err = 1;
-      return 1;
+      ghw_init_state = GHW_INIT_DONE;
+      return 0;
       }
    #endif
 
-   /* Test RGB-BGR setting (configured with GHW_COLOR_SWAP) */
-//    ghw_dispon(); /* placed here to ease initial debug */
-//    ghw_bufset( G_RED );
-//    ghw_bufset( G_GREEN );
-//    ghw_bufset( G_BLUE );
-   ghw_bufset( ghw_def_background );
-   ghw_dispon();     /* Turn display on after buffer clear */
+   ghw_init_idx = 0;
+   ghw_init_state = GHW_INIT_CLEAR;
+   return 0;
+   }
 
-   #ifndef GNOCURSOR
-   ghw_cursor = GCURSIZE1;    /* Cursor is off initially */
-   /* ghw_cursor = GCURSIZE1 | GCURON; */ /* Uncomment to set cursor on initially */
+/*
+   Start the initialization. Clears glcd_err status.
+   Only software settings are made here, the controller is accessed
+   by ghw_init_poll()
+
+   Return 0 if no error,
+   Return != 0 if some error
+*/
+SGBOOL ghw_init_start(void)
+   {
+   GHW_STATS_ENTRY(GHW_STAT_INIT);
+   glcd_err = 0;
+   ghw_init_state = GHW_INIT_IDLE;
+   ghw_io_init(); /* Set any hardware interface lines, assert controller hardware reset */
+
+   #if (defined( GHW_XMEM_BUF ) && defined( GBUFFER ))
+   ghw_xmem_init();
    #endif
 
-   ghw_updatehw();  /* Flush to display hdw or simulator */
+   #if (defined( GHW_ALLOCATE_BUF) && defined( GBUFFER ))
+   if (gbuf == NULL)
+      {
+      /* Allocate graphic ram buffer */
+      if ((gbuf = (GCOLOR *)calloc(ghw_gbufsize(),1)) == NULL)
+         glcd_err = 1;
+      else
+         gbuf_owner = 1;
+      }
+   #endif
+
+   if (glcd_err != 0)
+      return 1;
+
+   #ifdef GHW_PCSIM
+   /* Tell simulator about the visual LCD screen organization */
+   ghw_init_sim( GDISPW, GDISPH );
+   if (glcd_err != 0)
+      return 1;
+   #endif
+   /* Set default colors */
+   ghw_setcolor( GHW_PALETTE_FOREGROUND, GHW_PALETTE_BACKGROUND );
+
+   #if (GHW_PALETTE_SIZE > 0)
+   /* Load palette */
+   ghw_palette_wr(0, sizeof(ghw_palette)/sizeof(GPALETTE_RGB), (GCONSTP GPALETTE_RGB PFCODE *)&ghw_palette[0]);
+   #endif
+
+   /* No dirty area (after the palette load), the display is cleared by ghw_init_poll() */
+   #ifdef GBUFFER
+   ghw_updatehw_reset();
+   ghw_upddelay = 0;
+   #endif
+
+   ghw_init_idx = 0;
+   ghw_init_wait = 0;
+   ghw_init_tref = ghw_init_ticks;
+   ghw_init_state = GHW_INIT_IO;
+   return 0;
+   }
+
+/*
+   Clear the next GHW_INIT_CLEAR_PIXELS pixels (at most) of the display,
+   continuing inside a row.
+   Returns != 0 when the whole display is cleared
+*/
+static SGUCHAR ghw_init_clear_step(void)
+   {
+   SGULONG n;
+   GXT x;
+   GYT y,rows;
+
+   n = ((SGULONG) GDISPW) * GDISPH - ghw_init_idx;
+   if (n > GHW_INIT_CLEAR_PIXELS)
+      n = GHW_INIT_CLEAR_PIXELS;
+   x = (GXT)(ghw_init_idx % GDISPW);
+   y = (GYT)(ghw_init_idx / GDISPW);
+   if ((x == 0) && (n >= GDISPW))
+      {
+      /* Whole rows */
+      rows = (GYT)(n / GDISPW);
+      ghw_bufset( ghw_def_background, y, rows );
+      n = ((SGULONG) rows) * GDISPW;
+      }
+   else
+      {
+      /* Part of a row */
+      if (n > (SGULONG)(GDISPW - x))
+         n = GDISPW - x;
+      ghw_bufset_span( ghw_def_background, x, (GXT)(x + n - 1), y );
+      }
+   ghw_init_idx += n;
+   return (ghw_init_idx >= ((SGULONG) GDISPW) * GDISPH) ? 1 : 0;
+   }
+
+/*
+   Advance the initialization started by ghw_init_start() when the delay
+   requested by the previous step has elapsed.
+
+   Return != 0 while the initialization is in progress
+   Return 0 when completed (or not started). Check ghw_err() for the result
+*/
+SGUCHAR ghw_init_poll(void)
+   {
+   SGUCHAR elapsed;
+   SGUINT ms;
+
+   if ((ghw_init_state == GHW_INIT_IDLE) || (ghw_init_state == GHW_INIT_DONE))
+      return 0;
+
+   elapsed = (SGUCHAR)(ghw_init_ticks - ghw_init_tref);
+   ghw_init_tref += elapsed;
+   if (ghw_init_wait > elapsed)
+      {
+      ghw_init_wait -= elapsed;
+      return 1;
+      }
+
+   GHW_STATS_ENTRY(GHW_STAT_INIT);
+   ms = 0;
+   switch (ghw_init_state)
+      {
+      case GHW_INIT_IO:
+         if ((ms = ghw_io_init_step()) == GHW_IO_INIT_DONE)
+            {
+            ms = 0;
+            ghw_init_scr = &as1dregs[0];
+            ghw_init_state = GHW_INIT_REGS;
+            }
+         break;
+      case GHW_INIT_REGS:
+         ms = ghw_init_regs_step();
+         break;
+      case GHW_INIT_CLEAR:
+         /* Test RGB-BGR setting (configured with GHW_COLOR_SWAP) */
+         //    ghw_dispon(); /* placed here to ease initial debug */
+         //    ghw_bufset( G_RED, 0, GDISPH );
+         //    ghw_bufset( G_GREEN, 0, GDISPH );
+         //    ghw_bufset( G_BLUE, 0, GDISPH );
+         if (ghw_init_clear_step() != 0)
+            ghw_init_state = GHW_INIT_DISPON;
+         break;
+      default: /* GHW_INIT_DISPON */
+         ghw_dispon();     /* Turn display on after buffer clear */
+
+         #ifndef GNOCURSOR
+         ghw_cursor = GCURSIZE1;    /* Cursor is off initially */
+         /* ghw_cursor = GCURSIZE1 | GCURON; */ /* Uncomment to set cursor on initially */
+         #endif
+
+         ghw_updatehw();  /* Flush to display hdw or simulator */
+         ghw_init_state = GHW_INIT_DONE;
+         return 0;
+      }
+
+   /* +1 as the first tick may come right after this step */
+   ghw_init_wait = (ms != 0) ? ms + 1 : 0;
+   return (ghw_init_state != GHW_INIT_DONE) ? 1 : 0;
+   }
+
+/*
+   Initialize display, clear ram  (low-level)
+   Clears glcd_err status before init
+
+   Completes a non-blocking initialization if one has been started
+   with ghw_init_start(), otherwise makes a full initialization.
+
+   Return 0 if no error,
+   Return != 0 if some error
+*/
+SGBOOL ghw_init(void)
+   {
+   if (ghw_init_state == GHW_INIT_IDLE)
+      {
+      if (ghw_init_start() != 0)
+         return 1;
+      }
 
+   /* Run remaining steps, busy wait between them */
+   ghw_init_blocking = 1;
+   while (ghw_init_poll() != 0)
+      {
+      ghw_cmd_wait(1);
+      ghw_init_ticks++;
+      }
+   ghw_init_blocking = 0;
+   ghw_init_state = GHW_INIT_IDLE;
 
    return (glcd_err != 0) ? 1 : 0;
    }
@@ -2271,6 +3110,7 @@ void ghw_puterr( PGCSTR str )
    SGUINT xcnt;
    GXT xp;
    GYT yp,h,y, sidx;
+   GXT w;
    PGSYMBYTE psym;
    GCOLOR pval;
    SGUCHAR val;
@@ -2286,14 +3126,15 @@ void ghw_puterr( PGCSTR str )
    if (idx == NULL)
       return;
    xcnt = 1;
-   while(*idx)
+   while(GFLASH_RD(idx) != 0)
       {
-      if (*(idx++) == '\n')
+      if (GFLASH_RD(idx++) == '\n')
          xcnt++;
       }
 
    /* Set start character line */
-   h = SYSFONT.symheight;
+   h = GFLASH_RD(&SYSFONT.symheight);
+   w = GFLASH_RD(&SYSFONT.symwidth);
    yp = (xcnt*h > GDISPH) ? 0 : ((GDISPH-1)-xcnt*h)/2;
    /* Set character height in pixel lines */
 
@@ -2301,42 +3142,43 @@ void ghw_puterr( PGCSTR str )
    do
       {
       xcnt=0;  /* Set start x position so line is centered */
-      while ((idx[xcnt]!=0) && (idx[xcnt]!='\n') && (xcnt < GDISPBW))
+      while ((GFLASH_RD(&idx[xcnt])!=0) && (GFLASH_RD(&idx[xcnt])!='\n') && (xcnt < GDISPBW))
          {
          xcnt++;
          }
 
       /* Calculate start position for centered line */
-      xp = (GDISPW-xcnt*SYSFONT.symwidth)/2;
+      xp = (GDISPW-xcnt*w)/2;
 
       /* Display text line */
       while (xcnt-- > 0)
          {
          /* Point to graphic content for character symbol */
-         psym = &(sysfontsym[(*idx) & 0x7f].b[0]);
-         ghw_set_xyrange(xp,yp,xp+SYSFONT.symwidth-1,yp+(h-1));
+         psym = &(sysfontsym[GFLASH_RD(idx) & 0x7f].b[0]);
+         ghw_set_xyrange(xp,yp,xp+w-1,yp+(h-1));
 
          /* Display rows in symbol */
          for (y = 0; y < h; y++)
             {
-            /* Get symbol row value */
-            val = *psym++;
+            /* Get symbol row value (flash) */
+            val = GFLASH_RD(psym);
+            psym++;
             /* Initiate LCD controller address pointer */
             #ifdef GBUFFER
             gbufidx = GINDEX(xp, (GBUFINT)yp+y );
             #endif
 
             /* Display colums in symbol row */
-            for (sidx = 0; sidx < SYSFONT.symwidth; sidx++)
+            for (sidx = 0; sidx < w; sidx++)
                {
-               if ((val & sympixmsk[sidx]) != 0)
+               if ((val & GFLASH_RD(&sympixmsk[sidx])) != 0)
                   pval = ghw_def_foreground;
                else
                   pval = ghw_def_background;
 
                /* End of symbol or end of byte reached */
                #ifdef GBUFFER
-               gbuf[gbufidx++] = pval;
+               GBUF_WR(gbufidx++, pval);
                #endif
                ghw_auto_wr(pval);
                }
@@ -2344,16 +3186,19 @@ void ghw_puterr( PGCSTR str )
 
          ghw_auto_wr_end();
          idx++;
-         xp += SYSFONT.symwidth; /* Move to next symbol in line */
+         xp += w; /* Move to next symbol in line */
          }
 
       /* Next text line */
       yp += h;
-      if (*idx == '\n')
+      if (GFLASH_RD(idx) == '\n')
          idx++;
       }
-   while ((*idx != 0) && (yp < GDISPH));
+   while ((GFLASH_RD(idx) != 0) && (yp < GDISPH));
 
+   #ifdef GHW_ROW_HASH
+   ghw_rowhash_inval();  /* Display written directly */
+   #endif
    ghw_updatehw();  /* Flush to display hdw or simulator */
    }
 
@@ -2397,6 +3242,7 @@ void ghw_setcursor( GCURSOR type)
 */
 void ghw_dispoff(void)
    {
+   GHW_STATS_ENTRY(GHW_STAT_OTHER);
    #ifdef GHW_PCSIM
    ghw_dispoff_sim();
    #endif
@@ -2415,6 +3261,9 @@ void ghw_dispoff(void)
    #else
    ghw_cmd(GCTRL_DISPOFF);
    #endif
+   #ifdef GHW_WINDOW_CACHE
+   ghw_win_invalidate();  /* Controller may be put to sleep or reset while off */
+   #endif
    }
 
 /*
@@ -2422,6 +3271,7 @@ void ghw_dispoff(void)
 */
 void ghw_dispon(void)
    {
+   GHW_STATS_ENTRY(GHW_STAT_OTHER);
    #ifdef GHW_PCSIM
    ghw_dispon_sim();
    #endif
@@ -2441,6 +3291,9 @@ void ghw_dispon(void)
    #else
    ghw_cmd(GCTRL_DISPON);
    #endif
+   #ifdef GHW_WINDOW_CACHE
+   ghw_win_invalidate();
+   #endif
    }
 
 #if defined( GHW_ALLOCATE_BUF)
@@ -2518,11 +3371,7 @@ void ghw_set_state(SGUCHAR *buf, SGUCHAR doinit)
          ghw_cursor = ps->cursor;
          #endif
          ghw_upddelay = 0;        /* Force update of whole screen */
-         iltx = 0;
-         ilty = 0;
-         irbx = GDISPW-1;
-         irby = GDISPH-1;
-         ghw_updatehw();
+         ghw_flush_all();
          ghw_upddelay = (ps->upddelay != 0) ? 1 : 0;
          /* Restore drawing color */
          ghw_setcolor(ps->foreground, ps->background);
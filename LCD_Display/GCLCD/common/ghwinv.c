@@ -26,20 +26,47 @@
    Copyright (c) RAMTEX Engineering Aps 2007
 
 *********************************************************************/
-#include <s6d0129.h>   /* s6d0129 controller specific definements */
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
 
 #if (!defined( GNOCURSOR ) && defined (GSOFT_FONTS )) || defined (GGRAPHICS)
 #if (defined( GBUFFER ) || !defined(GHW_NO_LCD_READ_SUPPORT))
 
+#if (!defined( GBUFFER ) && !defined( GHW_NO_RDINC ))
+/*
+   Swap foreground and background colors in a chunk read by ghw_rmw_row()
+*/
+static void ghw_invert_op(GCOLOR *buf, SGUINT n)
+   {
+   register GCOLOR color, fore, back;
+   fore = ghw_def_foreground & GHW_COLOR_CMP_MSK;
+   back = ghw_def_background & GHW_COLOR_CMP_MSK;
+   for (; n != 0; n--, buf++)
+      {
+      color = *buf & GHW_COLOR_CMP_MSK;
+      if (color == fore)
+         *buf = ghw_def_background;
+      else
+      if (color == back)
+         *buf = ghw_def_foreground;
+      }
+   }
+#endif
+
 void ghw_invert(GXT ltx, GYT lty, GXT rbx, GYT rby)
    {
+   #if ((defined( GBUFFER ) && !defined( GHW_INDEXED_BUF )) || defined( GHW_NO_RDINC ))
    GXT x;
    register GCOLOR color, fore, back;
+   #endif
    #ifdef GBUFFER
    GBUFINT gbufidx;
    GBUF_CHECK();
    #endif
 
+   #ifdef GHW_BAND_ROWS
+   ghw_band_sync();   /* Needs the composed display content */
+   #endif
+   GHW_STATS_ENTRY(GHW_STAT_INVERT);
    glcd_err = 0;
 
    /* Force reasonable values */
@@ -51,29 +78,33 @@ void ghw_invert(GXT ltx, GYT lty, GXT rbx, GYT rby)
    GLIMITU(rbx,GDISPW-1);
 
    #ifdef GBUFFER
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
-   #else
+   ghw_invalrect( ltx, lty, rbx, rby );
    #endif
+   #if ((defined( GBUFFER ) && !defined( GHW_INDEXED_BUF )) || defined( GHW_NO_RDINC ))
    fore = ghw_def_foreground & GHW_COLOR_CMP_MSK;
    back = ghw_def_background & GHW_COLOR_CMP_MSK;
+   #endif
 
    for (; lty <= rby; lty++)
       {
       #ifdef GBUFFER
       gbufidx = GINDEX(ltx,lty);
+      #ifdef GHW_INDEXED_BUF
+      ghw_ibuf_invert(gbufidx, (GBUFINT)(rbx-ltx+1), ghw_def_foreground, ghw_def_background);
+      #else
       /* loop invert of colors */
       for (x = ltx; x <= rbx; x++)
          {
-         color = gbuf[gbufidx];
+         color = GBUF_RD(gbufidx);
          /* Swap foreground and background colors */
          if ((color & GHW_COLOR_CMP_MSK) == fore )
-            gbuf[gbufidx] = ghw_def_background;
+            GBUF_WR(gbufidx, ghw_def_background);
          else
          if ((color & GHW_COLOR_CMP_MSK) == back )
-            gbuf[gbufidx] = ghw_def_foreground;
+            GBUF_WR(gbufidx, ghw_def_foreground);
          gbufidx++;
          }
+      #endif
       #elif defined( GHW_NO_RDINC )
       ghw_set_xyrange(ltx,lty,rbx,lty);
       for (x = ltx; x <= rbx; x++)
@@ -88,27 +119,8 @@ void ghw_invert(GXT ltx, GYT lty, GXT rbx, GYT rby)
          ghw_auto_wr(color);
          }
       #else
-      GCOLOR *cp;
-      /* Loop pixel row read */
-      ghw_setxypos(ltx,lty);
-      ghw_auto_rd_start();
-      /* Loop pixel row read */
-      for (x = ltx, cp = &ghw_tmpbuf[0]; x <= rbx; x++, cp++)
-         *cp = ghw_auto_rd();
-
-      ghw_setxypos(ltx,lty);
-      for (x = ltx, cp = &ghw_tmpbuf[0]; x <= rbx; x++,cp++)
-         {
-         color = *cp;
-         /* Swap foreground and background colors */
-         if ((color & GHW_COLOR_CMP_MSK) == fore )
-            color = ghw_def_background;
-         else
-         if ((color & GHW_COLOR_CMP_MSK) == back )
-            color = ghw_def_foreground;
-         ghw_auto_wr(color);
-         }
-      ghw_auto_wr_end();
+      /* Read, invert and rewrite the row in chunks */
+      ghw_rmw_row(ltx, rbx, lty, lty, ghw_invert_op);
       #endif
       }
    }
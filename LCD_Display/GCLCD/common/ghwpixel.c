@@ -27,7 +27,7 @@
 
 *********************************************************************/
 
-#include <s6d0129.h>   /* s6d0129 controller specific definements */
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
 
 #ifdef GGRAPHICS
 
@@ -40,6 +40,7 @@ void ghw_setpixel( GXT x, GYT y, GCOLOR color )
    GBUF_CHECK();
    #endif
 
+   GHW_STATS_ENTRY(GHW_STAT_SETPIXEL);
    glcd_err = 0;
 
    /* Force resonable values */
@@ -47,9 +48,14 @@ void ghw_setpixel( GXT x, GYT y, GCOLOR color )
    GLIMITU(x,GDISPW-1);
    /* Calculate pixel position in byte */
 
+   #ifdef GHW_BAND_ROWS
+   if ((ghw_band_state == GHW_BAND_REC) && ghw_band_rec_pixel(x,y,color))
+      return;
+   #endif
+
    #ifdef GBUFFER
-   gbuf[GINDEX(x,y)] = color;
-   invalrect( x, y );
+   GBUF_WR(GINDEX(x,y), color);
+   ghw_invalrect( x, y, x, y );
    #else
    ghw_set_xyrange(x,y,x,y);  /* Initiate LCD controller address pointers*/
    ghw_auto_wr(color);
@@ -63,6 +69,10 @@ void ghw_setpixel( GXT x, GYT y, GCOLOR color )
 */
 GCOLOR ghw_getpixel(GXT x, GYT y)
    {
+   #ifdef GHW_BAND_ROWS
+   ghw_band_sync();   /* Needs the composed display content */
+   #endif
+   GHW_STATS_ENTRY(GHW_STAT_GETPIXEL);
    glcd_err = 0;
 
    /* Force resonable values */
@@ -78,7 +88,7 @@ GCOLOR ghw_getpixel(GXT x, GYT y)
       }
    #endif
    /* Calculate byte index */
-   return gbuf[GINDEX(x,y)];
+   return GBUF_RD(GINDEX(x,y));
    #else
     #ifdef GHW_NO_RDINC
      return ghw_rd(x,y);
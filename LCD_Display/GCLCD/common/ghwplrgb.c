@@ -15,7 +15,7 @@
    Copyright (c) RAMTEX Engineering Aps 2006-2009
 
 *******************************************************************/
-#include <s6d0129.h>   /* Display controller specific definements */
+#include <s6d0129x.h>   /* Display controller specific definements */
 
 #ifdef GBASIC_INIT_ERR
 
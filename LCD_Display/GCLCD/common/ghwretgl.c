@@ -29,7 +29,7 @@
 
 *********************************************************************/
 
-#include <s6d0129.h>   /* s6d0129 controller specific definements */
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
 
 #ifdef GGRAPHICS
 
@@ -43,22 +43,23 @@ static void ghw_lineh(GXT xb, GYT yb, GXT xe, GCOLOR color)
    {
    #ifdef GBUFFER
    GBUFINT gbufidx;
-   invalx( xb );
-   invalx( xe );
-   invaly( yb );
+   ghw_invalrect( xb, yb, xe, yb );
    gbufidx = GINDEX(xb,yb);
+   #ifdef GHW_INDEXED_BUF
+   ghw_ibuf_fill(gbufidx, (GBUFINT)(xe-xb+1), color);
+   #else
    for (; xb <= xe; xb++ )
       {
       /* Write destination */
-      gbuf[gbufidx++] = color;
+      GBUF_WR(gbufidx++, color);
       }
+   #endif
    if (ghw_upddelay == 0)
       ghw_updatehw();
    #else
 
    ghw_set_xyrange(xb,yb,xe,yb);
-   for (; xb <= xe; xb++ )
-      ghw_auto_wr(color);  /* Write destination */
+   ghw_auto_wr_repeat(color, (GBUFINT)(xe-xb+1));  /* Write destination */
    ghw_auto_wr_end();
    #endif
    }
@@ -70,14 +71,11 @@ static void ghw_linev(GXT xb, GYT yb, GYT ye, GCOLOR color)
    {
    #ifdef GBUFFER
    GBUFINT gbufidx;
-   invalx( xb );
-   invaly( yb );
-   invaly( ye );
-   gbufidx = GINDEX(xb,yb);
+   ghw_invalrect( xb, yb, xb, ye );
    for (; yb <= ye; yb++)
       {
-      gbuf[gbufidx] = color;
-      gbufidx += GDISPW;
+      gbufidx = GINDEX(xb,yb);
+      GBUF_WR(gbufidx, color);
       }
 
    if (ghw_upddelay == 0)
@@ -86,11 +84,7 @@ static void ghw_linev(GXT xb, GYT yb, GYT ye, GCOLOR color)
    #else
 
    ghw_set_xyrange(xb,yb,xb,ye);
-   while (yb <= ye )
-      {
-      ghw_auto_wr(color);
-      yb++;
-      }
+   ghw_auto_wr_repeat(color, (GBUFINT)(ye-yb+1));
    ghw_auto_wr_end();
    #endif
    }
@@ -106,6 +100,7 @@ static void ghw_linev(GXT xb, GYT yb, GYT ye, GCOLOR color)
 */
 void ghw_rectangle(GXT ltx, GYT lty, GXT rbx, GYT rby, GCOLOR color)
    {
+   GHW_STATS_ENTRY(GHW_STAT_RECTANGLE);
    glcd_err = 0;
 
    /* Force resonable values */
@@ -118,6 +113,10 @@ void ghw_rectangle(GXT ltx, GYT lty, GXT rbx, GYT rby, GCOLOR color)
    #ifdef GBUFFER
    GBUF_CHECK();
    #endif
+   #ifdef GHW_BAND_ROWS
+   if ((ghw_band_state == GHW_BAND_REC) && ghw_band_rec_rect(ltx,lty,rbx,rby,color))
+      return;
+   #endif
    if (ltx != rbx)
       ghw_lineh(ltx, lty, rbx, color);      /* Draw horisontal line */
 
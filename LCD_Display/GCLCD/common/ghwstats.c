@@ -0,0 +1,165 @@
+/************************** ghwstats.c *****************************
+
+   Display bus cost counters, see ghwstats.h
+
+   Compiled when GHW_STATS is defined in gdispcfg.h.
+
+   The bus counters are made by the ghw_tr_stats transport, which the
+   driver uses instead of ghw_tr when GHW_STATS is defined. It counts the
+   bytes, and models the CS and D/C line activity in the same way as the
+   SPI transports drive them, before forwarding to the active transport.
+
+*********************************************************************/
+#include <string.h>
+#include <s6d0129x.h>   /* controller specific definements, ghwstats.h */
+
+#ifdef GHW_STATS
+
+GHW_STATCNT ghw_stats_tab[GHW_STAT_ENTRIES];
+SGUCHAR ghw_stats_entry;
+
+#if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+
+/* Bus state model */
+#define ST_DC_CMD   0
+#define ST_DC_DATA  1
+#define ST_DC_NONE  2   /* Not known (after reset of the counters) */
+
+static SGUCHAR st_dc = ST_DC_NONE;  /* Last D/C level */
+static SGUCHAR st_frame;            /* 1 while a data burst holds CS */
+
+#define ST ghw_stats_tab[ghw_stats_entry]
+
+static void st_open(void)
+   {
+   st_frame = 0;
+   ghw_tr->open();
+   }
+
+static void st_flush(void)
+   {
+   st_frame = 0;
+   ghw_tr->flush();
+   }
+
+static void st_cmd(uint8_t cmd)
+   {
+   ST.cmd_bytes++;
+   ST.cs_assert++;
+   if (st_dc == ST_DC_DATA)
+      ST.dc_toggle++;
+   st_dc = ST_DC_CMD;
+   st_frame = 0;   /* A command ends an open data burst */
+   ghw_tr->write_cmd(cmd);
+   }
+
+/* Data byte(s) follow, open a data burst if needed */
+static void st_data_frame(void)
+   {
+   if (st_frame == 0)
+      {
+      ST.cs_assert++;
+      st_frame = 1;
+      }
+   if (st_dc == ST_DC_CMD)
+      ST.dc_toggle++;
+   st_dc = ST_DC_DATA;
+   }
+
+static void st_data(uint8_t dat)
+   {
+   st_data_frame();
+   ST.data_bytes++;
+   ghw_tr->write_data(dat);
+   }
+
+static void st_burst(const uint8_t *buf, uint16_t len)
+   {
+   st_data_frame();
+   ST.data_bytes += len;
+   ghw_tr->write_burst(buf, len);
+   }
+
+static void st_repeat(uint8_t hi, uint8_t lo, uint32_t count)
+   {
+   st_data_frame();
+   ST.data_bytes += 2*count;
+   ghw_tr->write_repeat(hi, lo, count);
+   }
+
+/* Command followed by read data, CS is held into the read */
+static void st_read_cmd(uint8_t cmd)
+   {
+   ST.cmd_bytes++;
+   ST.cs_assert++;
+   if (st_dc == ST_DC_DATA)
+      ST.dc_toggle++;
+   ST.dc_toggle++;  /* D/C high for the read data */
+   st_dc = ST_DC_DATA;
+   st_frame = 1;
+   ghw_tr->read_cmd(cmd);
+   }
+
+static uint8_t st_read(void)
+   {
+   st_data_frame();
+   ST.read_bytes++;
+   return ghw_tr->read_data();
+   }
+
+static void st_read_burst(uint8_t *buf, uint16_t len)
+   {
+   st_data_frame();
+   ST.read_bytes += len;
+   ghw_tr->read_burst(buf, len);
+   }
+
+const GHW_TRANSPORT ghw_tr_stats =
+   {
+   st_open, st_cmd, st_data, st_burst, st_repeat, st_read_cmd, st_read, st_read_burst, st_flush
+   };
+
+#endif /* GHW_USE_TRANSPORT */
+
+/*
+   Clear all counters
+*/
+void ghw_stats_reset(void)
+   {
+   memset(ghw_stats_tab, 0, sizeof(ghw_stats_tab));
+   #if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+   st_dc = ST_DC_NONE;
+   #endif
+   }
+
+/*
+   Copy the counters for entry to st.
+   With entry == GHW_STAT_ALL the sum of all entry points is returned
+*/
+void ghw_stats_get(SGUCHAR entry, GHW_STATCNT *st)
+   {
+   SGUCHAR i;
+   if (st == NULL)
+      return;
+   if (entry < GHW_STAT_ENTRIES)
+      {
+      *st = ghw_stats_tab[entry];
+      return;
+      }
+   memset(st, 0, sizeof(GHW_STATCNT));
+   for (i = 0; i < GHW_STAT_ENTRIES; i++)
+      {
+      st->calls      += ghw_stats_tab[i].calls;
+      st->cmd_bytes  += ghw_stats_tab[i].cmd_bytes;
+      st->data_bytes += ghw_stats_tab[i].data_bytes;
+      st->read_bytes += ghw_stats_tab[i].read_bytes;
+      st->cs_assert  += ghw_stats_tab[i].cs_assert;
+      st->dc_toggle  += ghw_stats_tab[i].dc_toggle;
+      st->windows    += ghw_stats_tab[i].windows;
+      st->pix_wr     += ghw_stats_tab[i].pix_wr;
+      st->pix_rd     += ghw_stats_tab[i].pix_rd;
+      st->rd_turn    += ghw_stats_tab[i].rd_turn;
+      }
+   }
+
+#endif /* GHW_STATS */
@@ -36,7 +36,7 @@
    Copyright (c) RAMTEX Engineering Aps 2006-2013
 
 *********************************************************************/
-#include <s6d0129.h>   /* lcd controller specific definements */
+#include <s6d0129x.h>   /* lcd controller specific definements */
 
 #ifdef GSOFT_SYMBOLS
 #if (defined( GBUFFER ) || !defined(GHW_NO_LCD_READ_SUPPORT))
@@ -52,13 +52,16 @@ SGUCHAR ghw_rdsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGUCHAR dest)
    GBUFINT gbufidx;
    #endif
 
+   #ifdef GHW_BAND_ROWS
+   ghw_band_sync();   /* Needs the composed display content */
+   #endif
+   GHW_STATS_ENTRY(GHW_STAT_RDSYM);
    glcd_err = 0;
    if (dest == NULL)
       return 0;
 
    #ifdef GBUFFER
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
+   ghw_invalrect( ltx, lty, rbx, rby );
    #endif
 
    #ifndef GBUFFER
@@ -79,7 +82,7 @@ SGUCHAR ghw_rdsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGUCHAR dest)
          {
          GCOLOR col;
          #ifdef GBUFFER
-         col = gbuf[gbufidx++];
+         col = GBUF_RD(gbufidx++);
          #else
 
          #ifdef GHW_NO_RDINC
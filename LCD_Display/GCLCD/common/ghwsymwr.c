@@ -53,7 +53,7 @@
    Copyright (c) RAMTEX Engineering Aps 2007-2014
 
 *********************************************************************/
-#include <s6d0129.h>   /* lcd controller specific definements */
+#include <s6d0129x.h>   /* lcd controller specific definements */
 
 #ifdef GVIRTUAL_FONTS
 #include <gvfont.h>
@@ -90,6 +90,8 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
    SGBOOL updatepos;
    #endif
 
+   GHW_STATS_ENTRY(GHW_STAT_WRSYM);
+
    #ifdef GVIRTUAL_FONTS
    if (bw == 0)
       return;
@@ -107,9 +109,13 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
    GLIMITU(rbx,GDISPW-1);
    GLIMITD(bw,1);
 
+   #ifdef GHW_BAND_ROWS
+   if ((ghw_band_state == GHW_BAND_REC) && ghw_band_rec_wrsym(ltx,lty,rbx,rby,src,bw,mode))
+      return;
+   #endif
+
    #ifdef GBUFFER
-   invalrect( ltx, lty );
-   invalrect( rbx, rby );
+   ghw_invalrect( ltx, lty, rbx, rby );
    #endif
 
    transperant = (mode & GHW_TRANSPERANT) ? 1 : 0;
@@ -195,8 +201,8 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
                   sval = gi_symv_by(sridx + sidx);
                else
                #endif
-                  /* Load new symbol byte from normal memory */
-                  sval = src[sridx + sidx];
+                  /* Load new symbol byte from flash or RAM */
+                  sval = GSYM_RD(&src[sridx + sidx]);
                sidx++;
                }
 
@@ -266,17 +272,17 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
             else
             #endif
                {
-               col = (SGULONG)(src[sridx + sidx++]);
+               col = (SGULONG)(GSYM_RD(&src[sridx + sidx++]));
                if (smode >= 16)
                   {
-                  col = (col<<8) + (SGULONG)(src[sridx + sidx++]);
+                  col = (col<<8) + (SGULONG)(GSYM_RD(&src[sridx + sidx++]));
                   if (smode > 16)
                      {
-                     col = (col<<8) + (SGULONG)(src[sridx + sidx++]);
+                     col = (col<<8) + (SGULONG)(GSYM_RD(&src[sridx + sidx++]));
                      if (smode > 24)
                         {
                         if (transperant)
-                           pval = src[sridx + sidx];
+                           pval = GSYM_RD(&src[sridx + sidx]);
                         else
                            pval = 0xff;
                         sidx++;
@@ -313,7 +319,7 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
                      #if (!defined( GHW_NO_LCD_READ_SUPPORT ) || defined(GBUFFER))
                       /* Transperant symbol mode, Read background pixel to do blending */
                       #ifdef GBUFFER
-                      back = gbuf[gbufidx];
+                      back = GBUF_RD(gbufidx);
                       #else
                       ghw_auto_wr_end();
                       ghw_set_xyrange(x,lty,rbx,rby);
@@ -344,7 +350,7 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
                }
 
             #ifdef GBUFFER
-            gbuf[gbufidx] = color;
+            GBUF_WR(gbufidx, color);
             #else
             /* Write and auto increment */
             if (updatepos)
@@ -367,5 +373,25 @@ void ghw_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGU
    ghw_auto_wr_end();
    }
 
+#ifdef GHW_FLASH_SYM
+SGUCHAR ghw_sym_ram;   /* ghw_wrsym() src is a RAM address */
+#endif
+
+/*
+   Write a symbol located in RAM (ex read with ghw_rdsym()).
+   With FCODE / PFCODE as __flash, ghw_wrsym() reads src from flash
+*/
+void ghw_wrsym_ram(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src, SGUINT bw, SGUCHAR mode)
+   {
+   #ifdef GHW_FLASH_SYM
+   SGUCHAR ram = ghw_sym_ram;
+   ghw_sym_ram = 1;
+   ghw_wrsym(ltx, lty, rbx, rby, (PGSYMBYTE)(SGUINT) src, bw, mode);
+   ghw_sym_ram = ram;
+   #else
+   ghw_wrsym(ltx, lty, rbx, rby, (PGSYMBYTE) src, bw, mode);
+   #endif
+   }
+
 #endif
 
@@ -0,0 +1,187 @@
+/************************** ghwxmem.c *****************************
+
+   Frame buffer in bank switched external SRAM, see GHW_XMEM_BUF in
+   gdispcfg.h
+
+   Compiled when GBUFFER and GHW_XMEM_BUF are defined.
+
+   The ATmega2560 external memory interface maps the upper 32 KB of the
+   data space (GHW_XMEM_BASE) to the SRAM. PC7 (A15) is released from the
+   interface, so the SRAM address lines from A15 and up are driven by a
+   bank latch on GHW_XMEM_BANK_PORT instead. The CPU sees one bank of
+   GHW_XMEM_BANK_SIZE bytes at a time.
+
+   Each bank holds GHW_XMEM_ROWS whole display rows, so a row is always
+   contiguous in the window. GINDEX() (s6d0129x.h) returns the bank in
+   bit 16-23 and the pixel offset in the bank in bit 0-15. The ghw_
+   functions access the buffer via GBUF_RD() / GBUF_WR() / GBUF_PTR(),
+   which switch bank when needed. A pointer from GBUF_PTR() is valid for
+   the rest of the row, until the next buffer access.
+
+   With GHW_INDEXED_BUF the banks hold the palette indices instead
+   (ghwibuf.c), which accesses them with ghw_xmem_bptr(). The 75 KB or
+   150 KB index buffer for 480x320 then fits in 3 or 5 banks.
+
+   With GHW_ROW_HASH the row hash table of ghwbuf.c is kept in the bank
+   after the frame buffer (GHW_XMEM_HASH), accessed with ghw_xmem_bptr().
+
+   The XMEM bus uses PORTA (AD0-AD7), PORTC (A8-A14) and PG0-PG2, which
+   can then not be used for the display interface lines. The build stops
+   if the TFT D/C or CS line is on PORTA or PORTC (TFT_spi.h).
+
+   In the host build the bank logic is modelled: the window is a separate
+   array which is exchanged with the SRAM array when the bank is changed,
+   so a stale window pointer shows the same faults as on the hardware.
+
+*********************************************************************/
+#include <string.h>
+#include <s6d0129x.h>   /* s6d0129 controller specific definements */
+
+#if (defined( GBUFFER ) && defined( GHW_XMEM_BUF ))
+
+#ifdef __AVR__
+#include <avr/io.h>
+#include "TFT_spi.h"
+
+/* Ports used by the XMEM bus (AD0-AD7, A8-A14) */
+#define GHW_XMEM_IO_A 1
+#define GHW_XMEM_IO_C 1
+#define GHW_XMEM_IO(io)  GHW_XMEM_IO_(io)
+#define GHW_XMEM_IO_(io) (GHW_XMEM_IO_##io + 0)
+#if (GHW_XMEM_IO( TFT_SPI_DC_IO ) || GHW_XMEM_IO( TFT_SPI_CS_IO ))
+  #error The TFT D/C or CS line is on PORTA / PORTC, which carry the XMEM bus with GHW_XMEM_BUF (move it in TFT_spi.h)
+#endif
+#endif
+
+#ifdef GHW_ALLOCATE_BUF
+  #error GHW_XMEM_BUF can not be used with GHW_ALLOCATE_BUF
+#endif
+
+#ifndef GHW_XMEM_BANK_PORT
+  #define GHW_XMEM_BANK_PORT  PORTL   /* Bank latch, SRAM A15 and up */
+  #define GHW_XMEM_BANK_DDR   DDRL
+  #define GHW_XMEM_BANK_SHIFT 0       /* Port bit driving A15 */
+  #define GHW_XMEM_BANK_BITS  4       /* Number of bank lines */
+#endif
+
+#if (GHW_XMEM_ROWS < 1)
+  #error GHW_XMEM_BANK_SIZE is less than one display row
+#endif
+#if (GHW_XMEM_USED > (1 << GHW_XMEM_BANK_BITS))
+  #error Frame buffer needs more banks than GHW_XMEM_BANK_BITS can select
+#endif
+
+/* Pixels copied between two banks at a time by ghw_xmem_copy() */
+#define GHW_XMEM_CHUNK 32
+
+static SGUCHAR ghw_xmem_bank;   /* Selected bank */
+
+#ifdef __AVR__
+
+#define GHW_XMEM_WIN ((GCOLOR *) GHW_XMEM_BASE)
+
+static void ghw_xmem_select(SGUCHAR bank)
+   {
+   GHW_XMEM_BANK_PORT = (GHW_XMEM_BANK_PORT & ~(((1 << GHW_XMEM_BANK_BITS) - 1) << GHW_XMEM_BANK_SHIFT)) |
+                        (bank << GHW_XMEM_BANK_SHIFT);
+   ghw_xmem_bank = bank;
+   }
+
+/*
+   Enable the external memory interface and the bank latch
+*/
+void ghw_xmem_init(void)
+   {
+   XMCRB = (1<<XMM0);   /* Release PC7 (A15), driven by the bank latch */
+   XMCRA = (1<<SRE);    /* Enable XMEM, no wait states */
+   GHW_XMEM_BANK_DDR |= ((1 << GHW_XMEM_BANK_BITS) - 1) << GHW_XMEM_BANK_SHIFT;
+   ghw_xmem_select(0);
+   }
+
+#else /* __AVR__ */
+
+/* Host model of the SRAM and the window */
+static GCOLOR ghw_xmem_win[GHW_XMEM_BANK_SIZE / sizeof(GCOLOR)];
+static GCOLOR ghw_xmem_sram[GHW_XMEM_USED][GHW_XMEM_BANK_SIZE / sizeof(GCOLOR)];
+SGULONG ghw_xmem_switches;      /* Number of bank changes */
+
+#define GHW_XMEM_WIN ghw_xmem_win
+
+static void ghw_xmem_select(SGUCHAR bank)
+   {
+   memcpy(ghw_xmem_sram[ghw_xmem_bank], ghw_xmem_win, sizeof(ghw_xmem_win));
+   memcpy(ghw_xmem_win, ghw_xmem_sram[bank], sizeof(ghw_xmem_win));
+   ghw_xmem_bank = bank;
+   ghw_xmem_switches++;
+   }
+
+void ghw_xmem_init(void)
+   {
+   ghw_xmem_bank = 0;
+   memcpy(ghw_xmem_win, ghw_xmem_sram[0], sizeof(ghw_xmem_win));
+   }
+
+#endif /* __AVR__ */
+
+/*
+   Select the bank in bit 16-23 of boffs and return a window pointer to
+   the byte at offset bit 0-15
+*/
+SGUCHAR *ghw_xmem_bptr(GBUFINT boffs)
+   {
+   SGUCHAR bank = (SGUCHAR)(boffs >> 16);
+   if (bank != ghw_xmem_bank)
+      ghw_xmem_select(bank);
+   return &((SGUCHAR *) GHW_XMEM_WIN)[(SGUINT) boffs];
+   }
+
+#ifndef GHW_INDEXED_BUF
+/*
+   Select the bank holding buffer index idx and return a window pointer
+   to the pixel
+*/
+GCOLOR *ghw_xmem_ptr(GBUFINT idx)
+   {
+   SGUCHAR bank = (SGUCHAR)(idx >> 16);
+   if (bank != ghw_xmem_bank)
+      ghw_xmem_select(bank);
+   return &GHW_XMEM_WIN[(SGUINT) idx];
+   }
+
+GCOLOR ghw_xmem_rd(GBUFINT idx)
+   {
+   return *ghw_xmem_ptr(idx);
+   }
+
+void ghw_xmem_wr(GBUFINT idx, GCOLOR color)
+   {
+   *ghw_xmem_ptr(idx) = color;
+   }
+
+/*
+   Copy n pixels in a row from buffer index src to buffer index dst.
+   Pixels in another bank are moved via a small buffer.
+*/
+void ghw_xmem_copy(GBUFINT dst, GBUFINT src, GBUFINT n)
+   {
+   GCOLOR tmp[GHW_XMEM_CHUNK];
+   SGUINT i;
+   if ((SGUCHAR)(dst >> 16) == (SGUCHAR)(src >> 16))
+      {
+      GCOLOR *dp = ghw_xmem_ptr(dst);
+      memmove(dp, &GHW_XMEM_WIN[(SGUINT) src], (size_t) n * sizeof(GCOLOR));
+      return;
+      }
+   while (n > 0)
+      {
+      i = (n > GHW_XMEM_CHUNK) ? GHW_XMEM_CHUNK : (SGUINT) n;
+      memcpy(tmp, ghw_xmem_ptr(src), i * sizeof(GCOLOR));
+      memcpy(ghw_xmem_ptr(dst), tmp, i * sizeof(GCOLOR));
+      src += i;
+      dst += i;
+      n -= i;
+      }
+   }
+#endif /* GHW_INDEXED_BUF */
+
+#endif /* GBUFFER && GHW_XMEM_BUF */
@@ -17,13 +17,31 @@
 #include <stdint.h>
 #include <gdisphw.h>
 #include "hx8357d.h"
+#ifdef __AVR__
 #include "TFT_spi.h"
-#include <util/delay.h> // For _delay_ms
+#else
+// Host build, the display is emulated behind the mock transport (host/hx8357emu.c)
+#define TFT_RST_INIT()
+#define TFT_RST_LOW()
+#define TFT_RST_HIGH()
+#endif
+#include "ghwtrans.h"
+#include <s6d0129x.h>  /* ghw_io_init_step() */
 #ifdef GHW_SINGLE_CHIP
 //void sim_reset( void );
 #endif
 
 #ifdef GBASIC_INIT_ERR
+
+/* Progress of the controller bring-up done by ghw_io_init_step() */
+#define IO_INIT_RESET   0   /* Hardware reset asserted by ghw_io_init() */
+#define IO_INIT_RELEASE 1   /* Release reset, wait for the controller */
+#define IO_INIT_SCRIPT  2   /* Interpret hx8357d_init */
+#define IO_INIT_DONE    3
+
+static uint8_t io_init_state = IO_INIT_DONE;
+static GCODE SGUCHAR *io_init_addr; // next hx8357d_init entry (in flash)
+
 /*
    ghw_io_init()
 
@@ -31,6 +49,9 @@
    controller registers is addressed. Any target system specific
    initialization like I/O port initialization can be placed here.
 
+   The function does not wait. It asserts the hardware reset and arms the
+   controller start-up sequence, which is then executed by repeated calls
+   of ghw_io_init_step().
 */
 void ghw_io_init(void)
 {
@@ -39,39 +60,52 @@ void ghw_io_init(void)
    //sim_reset();  /* Initiate LCD bus simulation ports */
    #endif
    
-     // Initialize pins for CS and DC (and RST if needed)
-     TFT_PINS_INIT();
+     // Initialize pins for CS and DC and the display transport
+     ghw_tr->open();
 
-    // Hardware Reset Sequence
+    // Hardware Reset Sequence, released by ghw_io_init_step()
+	TFT_RST_INIT();  // RST pin as output (high) whatever transport is used
 	TFT_RST_LOW();
-    //_delay_ms(10);
-    
-	TFT_RST_HIGH();
-    //_delay_ms(150);
-	
-	// Send initialization commands
-	const uint8_t *addr = hx8357d_init;
-	while (*addr)
+	io_init_addr = hx8357d_init;
+	io_init_state = IO_INIT_RESET;
+	#endif
+}
+
+/*
+   ghw_io_init_step()
+
+   Execute the next step of the controller start-up sequence armed by
+   ghw_io_init(): reset pulse, then one hx8357d_init script entry per call.
+
+   Returns the number of milli seconds which must elapse before the next
+   call, or GHW_IO_INIT_DONE when the sequence is complete.
+*/
+SGUINT ghw_io_init_step(void)
+{
+	#ifndef GHW_NOHDW
+	SGUINT ms;
+
+	switch (io_init_state)
 	{
-		uint8_t cmd = *addr++;
-		uint8_t numArgs = *addr & 0x7F;
-		//uint8_t delayFlag = *addr++ & 0x80;
-		
-		spi_tft_sendCommand(cmd);
-		for (uint8_t i = 0; i < numArgs; i++)
-		{
-			spi_tft_sendData(*addr++);
-		}
-
-		//if (delayFlag)
-		{
-			//_delay_ms(5 * numArgs);
-			//for(uint8_t i = 0; i < numArgs; i++)
-			//_delay_ms(5); // 5 ms * numArgs total
-
-		}
+	case IO_INIT_RESET:
+		io_init_state = IO_INIT_RELEASE;
+		return 10; // Hold reset low for 10 ms
+	case IO_INIT_RELEASE:
+		TFT_RST_HIGH();
+		io_init_state = IO_INIT_SCRIPT;
+		return 150; // Wait for the controller to come out of reset
+	case IO_INIT_SCRIPT:
+		// One script entry, its arguments are sent as one burst
+		ms = ghw_script_step(&io_init_addr);
+		if (ms != GSCR_DONE)
+			return ms;
+		break;
+	default:
+		break;
 	}
+	io_init_state = IO_INIT_DONE;
 	#endif
+	return GHW_IO_INIT_DONE;
 }
 
 /*
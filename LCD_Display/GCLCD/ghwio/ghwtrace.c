@@ -0,0 +1,231 @@
+/***************************** ghwtrace.c ************************************
+
+   Display bus trace recorder, see ghwtrace.h
+
+   Compiled when GHW_TRACE is defined in gdispcfg.h.
+
+   The recorder transport forwards all calls to the transport which was
+   active when ghw_trace_start() was called, and records the bytes on the
+   way.
+
+****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+#include <gdisphw.h>    /* gdispcfg.h */
+#include "ghwtrans.h"
+#include "ghwtrace.h"
+
+#ifdef GHW_TRACE
+
+#if (GHW_TRACE_SIZE < 2*GHW_TRC_REC_MAX)
+  #error GHW_TRACE_SIZE too small
+#endif
+
+void (*ghw_trace_sink)(const uint8_t *rec, uint8_t len);
+uint16_t ghw_trace_lost;
+
+static const GHW_TRANSPORT *trc_next;   /* Traced transport */
+
+/********************* RAM ring *********************/
+
+static uint8_t trc_ring[GHW_TRACE_SIZE];
+static uint16_t trc_tail;   /* Oldest record */
+static uint16_t trc_used;   /* Bytes in ring */
+
+static uint8_t trc_at(uint16_t i)
+   {
+   i += trc_tail;
+   if (i >= GHW_TRACE_SIZE)
+      i -= GHW_TRACE_SIZE;
+   return trc_ring[i];
+   }
+
+/* Size of the oldest record */
+static uint8_t trc_reclen(void)
+   {
+   switch (trc_at(0))
+      {
+      case GHW_TRC_BURST:  return (uint8_t)(2 + trc_at(1));
+      case GHW_TRC_REPEAT: return 7;
+      case GHW_TRC_FLUSH:
+      case GHW_TRC_FRAME:  return 1;
+      default:             return 2;
+      }
+   }
+
+static void trc_drop(uint8_t len)
+   {
+   trc_tail += len;
+   if (trc_tail >= GHW_TRACE_SIZE)
+      trc_tail -= GHW_TRACE_SIZE;
+   trc_used -= len;
+   }
+
+static void trc_put(const uint8_t *rec, uint8_t len)
+   {
+   uint16_t i;
+   if (ghw_trace_sink != 0)
+      {
+      ghw_trace_sink(rec, len);
+      return;
+      }
+   /* Make room by dropping the oldest records */
+   while (GHW_TRACE_SIZE - trc_used < len)
+      {
+      trc_drop(trc_reclen());
+      ghw_trace_lost++;
+      }
+   i = trc_tail + trc_used;
+   if (i >= GHW_TRACE_SIZE)
+      i -= GHW_TRACE_SIZE;
+   trc_used += len;
+   while (len--)
+      {
+      trc_ring[i] = *rec++;
+      if (++i >= GHW_TRACE_SIZE)
+         i = 0;
+      }
+   }
+
+uint16_t ghw_trace_read(uint8_t *buf, uint16_t size)
+   {
+   uint16_t n = 0;
+   uint8_t len,i;
+   if (buf == 0)
+      return 0;
+   while (trc_used != 0)
+      {
+      len = trc_reclen();
+      if (n + len > size)
+         break;
+      for (i = 0; i < len; i++)
+         buf[n++] = trc_at(i);
+      trc_drop(len);
+      }
+   return n;
+   }
+
+/********************* Recorder transport *********************/
+
+static void trc_rec1(uint8_t tag)
+   {
+   trc_put(&tag, 1);
+   }
+
+static void trc_rec2(uint8_t tag, uint8_t dat)
+   {
+   uint8_t rec[2];
+   rec[0] = tag;
+   rec[1] = dat;
+   trc_put(rec, 2);
+   }
+
+static void trc_open(void)
+   {
+   trc_next->open();
+   }
+
+static void trc_cmd(uint8_t cmd)
+   {
+   trc_rec2(GHW_TRC_CMD, cmd);
+   trc_next->write_cmd(cmd);
+   }
+
+static void trc_data(uint8_t dat)
+   {
+   trc_rec2(GHW_TRC_DATA, dat);
+   trc_next->write_data(dat);
+   }
+
+static void trc_burst(const uint8_t *buf, uint16_t len)
+   {
+   uint8_t rec[GHW_TRC_REC_MAX];
+   uint16_t i;
+   uint8_t n;
+   for (i = 0; i < len; i += n)
+      {
+      n = (uint8_t)(((len - i) > GHW_TRC_BURST_MAX) ? GHW_TRC_BURST_MAX : (len - i));
+      rec[0] = GHW_TRC_BURST;
+      rec[1] = n;
+      memcpy(&rec[2], &buf[i], n);
+      trc_put(rec, (uint8_t)(n+2));
+      }
+   trc_next->write_burst(buf, len);
+   }
+
+static void trc_repeat(uint8_t hi, uint8_t lo, uint32_t count)
+   {
+   uint8_t rec[7];
+   rec[0] = GHW_TRC_REPEAT;
+   rec[1] = hi;
+   rec[2] = lo;
+   rec[3] = (uint8_t) count;
+   rec[4] = (uint8_t)(count >> 8);
+   rec[5] = (uint8_t)(count >> 16);
+   rec[6] = (uint8_t)(count >> 24);
+   trc_put(rec, 7);
+   trc_next->write_repeat(hi, lo, count);
+   }
+
+static void trc_read_cmd(uint8_t cmd)
+   {
+   trc_rec2(GHW_TRC_CMD, cmd);
+   trc_next->read_cmd(cmd);
+   }
+
+static uint8_t trc_read(void)
+   {
+   uint8_t dat = trc_next->read_data();
+   trc_rec2(GHW_TRC_READ, dat);
+   return dat;
+   }
+
+static void trc_read_burst(uint8_t *buf, uint16_t len)
+   {
+   trc_next->read_burst(buf, len);
+   while (len--)
+      trc_rec2(GHW_TRC_READ, *buf++);
+   }
+
+static void trc_flush(void)
+   {
+   trc_rec1(GHW_TRC_FLUSH);
+   trc_next->flush();
+   }
+
+static const GHW_TRANSPORT ghw_tr_trace =
+   {
+   trc_open, trc_cmd, trc_data, trc_burst, trc_repeat, trc_read_cmd, trc_read, trc_read_burst, trc_flush
+   };
+
+/*
+   Start recording of the active transport
+*/
+void ghw_trace_start(void)
+   {
+   if (ghw_tr == &ghw_tr_trace)
+      return;
+   trc_next = ghw_tr;
+   ghw_tr = &ghw_tr_trace;
+   }
+
+/*
+   Stop recording, the traced transport is used directly again
+*/
+void ghw_trace_stop(void)
+   {
+   if (ghw_tr != &ghw_tr_trace)
+      return;
+   ghw_tr = trc_next;
+   }
+
+/*
+   Mark the end of a frame (a complete screen update)
+*/
+void ghw_trace_frame(void)
+   {
+   if (ghw_tr == &ghw_tr_trace)
+      trc_rec1(GHW_TRC_FRAME);
+   }
+
+#endif /* GHW_TRACE */
@@ -0,0 +1,290 @@
+/***************************** ghwtrans.c ************************************
+
+   Display bus transports, see ghwtrans.h
+
+   The SPI module and USART SPI transports are implemented in TFT_spi.c.
+   This module holds the active transport selection, the bit-bang SPI
+   transport, the parallel bus transport (via the bussim.c access
+   functions) and the mock transport used for host builds and benchmarks.
+
+****************************************************************************/
+#include <stdint.h>
+#ifdef GHW_SINGLE_CHIP
+#include <bussim.h>     /* simwrby(), simrdby(), GHWCMD, GHWWR, GHWRD */
+#endif
+#ifdef __AVR__
+#include <avr/io.h>
+#include "spi4.h"
+#include "TFT_spi.h"
+#endif
+#include "ghwtrans.h"
+
+/********************* Transport selection *********************/
+
+#if defined( __AVR__ ) && defined( TFT_USART_SPI )
+   #define GHW_TR_DEFAULT ghw_tr_usartspi
+#elif defined( __AVR__ )
+   #define GHW_TR_DEFAULT ghw_tr_hwspi
+#else
+   #define GHW_TR_DEFAULT ghw_tr_mock
+#endif
+
+const GHW_TRANSPORT *ghw_tr = &GHW_TR_DEFAULT;
+
+/*
+   Make tr the active transport.
+   Pending writes on the previous transport are completed first.
+*/
+void ghw_transport_select(const GHW_TRANSPORT *tr)
+   {
+   if (tr == 0)
+      return;
+   ghw_tr->flush();
+   ghw_tr = tr;
+   ghw_tr->open();
+   }
+
+/********************* Bit-bang SPI transport *********************/
+
+#ifdef __AVR__
+/*
+   Software SPI (mode 0, msb first) on the SPI module pins with the SPI
+   module disabled. Slow, but independent of the peripherals, which makes
+   it a reference when a hardware transport misbehaves.
+*/
+static uint8_t bb_open_frame; /* 1 while CS is held low for data */
+
+static uint8_t bb_shift(uint8_t dat)
+   {
+   uint8_t i;
+   for (i = 0; i < 8; i++)
+      {
+      if (dat & 0x80)
+         SPIPORT |= SPI_MOSI;
+      else
+         SPIPORT &= ~SPI_MOSI;
+      dat <<= 1;
+      SPIPORT |= SPI_SCK;             /* Sample on rising edge */
+      if (PINB & SPI_MISO)
+         dat |= 0x01;
+      SPIPORT &= ~SPI_SCK;
+      }
+   return dat;
+   }
+
+static void bb_open(void)
+   {
+   SPCR &= ~(1<<SPE);                 /* Release pins from the SPI module */
+   SPIDDR |= (SPI_MOSI | SPI_SCK);
+   SPIPORT &= ~SPI_SCK;
+   TFT_PINS_INIT();
+   TFT_CS_HIGH();
+   bb_open_frame = 0;
+   }
+
+static void bb_flush(void)
+   {
+   if (bb_open_frame)
+      {
+      TFT_CS_HIGH();
+      bb_open_frame = 0;
+      }
+   }
+
+static void bb_cmd(uint8_t cmd)
+   {
+   bb_flush();
+   TFT_DC_LOW();
+   TFT_CS_LOW();
+   bb_shift(cmd);
+   TFT_CS_HIGH();
+   }
+
+static void bb_frame(void)
+   {
+   if (!bb_open_frame)
+      {
+      TFT_DC_HIGH();
+      TFT_CS_LOW();
+      bb_open_frame = 1;
+      }
+   }
+
+static void bb_data(uint8_t dat)
+   {
+   bb_frame();
+   bb_shift(dat);
+   }
+
+static void bb_burst(const uint8_t *buf, uint16_t len)
+   {
+   bb_frame();
+   while (len--)
+      bb_shift(*buf++);
+   }
+
+static void bb_repeat(uint8_t hi, uint8_t lo, uint32_t count)
+   {
+   bb_frame();
+   while (count--)
+      {
+      bb_shift(hi);
+      bb_shift(lo);
+      }
+   }
+
+/* CS stays low from the command into the read data */
+static void bb_read_cmd(uint8_t cmd)
+   {
+   bb_flush();
+   TFT_DC_LOW();
+   TFT_CS_LOW();
+   bb_shift(cmd);
+   TFT_DC_HIGH();
+   bb_open_frame = 1;
+   }
+
+static uint8_t bb_read(void)
+   {
+   bb_frame();
+   return bb_shift(0xff);
+   }
+
+static void bb_read_burst(uint8_t *buf, uint16_t len)
+   {
+   bb_frame();
+   while (len--)
+      *buf++ = bb_shift(0xff);
+   }
+
+const GHW_TRANSPORT ghw_tr_bitbang =
+   {
+   bb_open, bb_cmd, bb_data, bb_burst, bb_repeat, bb_read_cmd, bb_read, bb_read_burst, bb_flush
+   };
+#endif /* __AVR__ */
+
+/********************* Parallel bus transport *********************/
+
+#if defined( GHW_SINGLE_CHIP ) && defined( GHW_BUS8 )
+/*
+   8 bit Intel (8080) bus. The bus cycles are generated by the
+   simwrby() / simrdby() functions in bussim.c, which must be implemented
+   for the port pins used.
+*/
+static void par_open(void)
+   {
+   sim_reset();
+   }
+
+static void par_flush(void)
+   {
+   }
+
+static void par_cmd(uint8_t cmd)
+   {
+   simwrby(GHWCMD, cmd);
+   }
+
+static void par_data(uint8_t dat)
+   {
+   simwrby(GHWWR, dat);
+   }
+
+static void par_burst(const uint8_t *buf, uint16_t len)
+   {
+   while (len--)
+      simwrby(GHWWR, *buf++);
+   }
+
+static void par_repeat(uint8_t hi, uint8_t lo, uint32_t count)
+   {
+   while (count--)
+      {
+      simwrby(GHWWR, hi);
+      simwrby(GHWWR, lo);
+      }
+   }
+
+static uint8_t par_read(void)
+   {
+   return simrdby(GHWRD);
+   }
+
+static void par_read_burst(uint8_t *buf, uint16_t len)
+   {
+   while (len--)
+      *buf++ = simrdby(GHWRD);
+   }
+
+const GHW_TRANSPORT ghw_tr_parallel =
+   {
+   par_open, par_cmd, par_data, par_burst, par_repeat, par_cmd, par_read, par_read_burst, par_flush
+   };
+#endif
+
+/********************* Mock transport *********************/
+
+/*
+   No hardware access. Every byte is counted and passed to
+   ghw_tr_mock_sink (if set), read data is taken from ghw_tr_mock_source
+   (if set). Used for host builds, the display emulator and for measuring
+   the bus traffic generated by the driver.
+*/
+GHW_TR_MOCKSTAT ghw_tr_mockstat;
+void (*ghw_tr_mock_sink)(uint8_t isdata, uint8_t dat);
+uint8_t (*ghw_tr_mock_source)(void);
+
+static void mock_open(void)
+   {
+   }
+
+static void mock_flush(void)
+   {
+   ghw_tr_mockstat.flushes++;
+   }
+
+static void mock_cmd(uint8_t cmd)
+   {
+   ghw_tr_mockstat.cmds++;
+   if (ghw_tr_mock_sink != 0)
+      ghw_tr_mock_sink(0, cmd);
+   }
+
+static void mock_data(uint8_t dat)
+   {
+   ghw_tr_mockstat.data++;
+   if (ghw_tr_mock_sink != 0)
+      ghw_tr_mock_sink(1, dat);
+   }
+
+static void mock_burst(const uint8_t *buf, uint16_t len)
+   {
+   while (len--)
+      mock_data(*buf++);
+   }
+
+static void mock_repeat(uint8_t hi, uint8_t lo, uint32_t count)
+   {
+   while (count--)
+      {
+      mock_data(hi);
+      mock_data(lo);
+      }
+   }
+
+static uint8_t mock_read(void)
+   {
+   ghw_tr_mockstat.reads++;
+   return (ghw_tr_mock_source != 0) ? ghw_tr_mock_source() : 0;
+   }
+
+static void mock_read_burst(uint8_t *buf, uint16_t len)
+   {
+   while (len--)
+      *buf++ = mock_read();
+   }
+
+const GHW_TRANSPORT ghw_tr_mock =
+   {
+   mock_open, mock_cmd, mock_data, mock_burst, mock_repeat, mock_cmd, mock_read, mock_read_burst, mock_flush
+   };
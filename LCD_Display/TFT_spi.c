@@ -4,26 +4,202 @@
  * Created: 6/3/2025 2:33:57 PM
  *  Author: Steve
 *  spi_tft_sendData modified to handle CS duties
+*  burst functions added: D/C and CS are held for a whole RAMWR payload
+*  TFT can be driven by the SPI module or by USART1 in SPI mode
+*  provides the hwspi and usartspi display transports
+*  read path: CS held from a read command into the data, burst reads
 *
 */ 
 #include <avr/io.h>
 #include "spi4.h"
 #include "TFT_spi.h"
 
+#include "usart_spi.h"
+#include "ghwtrans.h"
+
+// Port used for the TFT: SPI module or USART1 in SPI mode.
+// The default is set with TFT_USART_SPI in TFT_spi.h, selecting the
+// ghw_tr_hwspi or ghw_tr_usartspi transport switches it at run time.
+#ifdef TFT_USART_SPI
+static uint8_t tft_usart = 1;
+#else
+static uint8_t tft_usart = 0;
+#endif
+
+#define TFT_TRANSFER(d)  (tft_usart ? USART_SPI_Transfer(d) : SPI_Transfer(d))
+#define TFT_WRITE(d)     do { if (tft_usart) USART_SPI_Write(d); else SPI_Write(d); } while(0)
+#define TFT_WAIT()       do { if (tft_usart) USART_SPI_Wait(); else SPI_Wait(); } while(0)
+#define TFT_WRITE_END()  do { if (tft_usart) { USART_SPI_Wait(); TFT_CS_HIGH(); } \
+                              else SPI_WriteEnd(&TFT_SPI_CS_PORT, TFT_SPI_CS_MASK); } while(0)
+
+static uint8_t tft_burst; // 1 while a data burst holds D/C high and CS low
+
+// Set up the TFT control pins and the transport
+void spi_tft_init(void)
+{
+	TFT_PINS_INIT();
+	TFT_CS_HIGH();
+	if (tft_usart)
+		init_usart_spi();
+}
 // Set D/C low for command, send byte over SPI
 void spi_tft_sendCommand(uint8_t cmd) 
 {
+	spi_tft_endData();  // a command always terminates an open data burst
+	TFT_WAIT();         // D/C must not change before queued data is out
 	TFT_DC_LOW();       // D/C = 0 for command
 	TFT_CS_LOW();   // Select the TFT 
-	SPI_Transfer(cmd);  // Send byte via SPI (implement this for your MCU)
+	TFT_TRANSFER(cmd);  // Send byte via SPI (implement this for your MCU)
 	TFT_CS_HIGH();  // De-select TFT
 }
 
 // Function to perform SPI communication with the TFT display
 void spi_tft_sendData(uint8_t data) 
 {
+	if (tft_burst)
+	{
+		TFT_WRITE(data); // Append to the open burst
+		return;
+	}
+	TFT_WAIT();         // a closing burst may still own CS
 	TFT_DC_HIGH();      // D/C = 1 for data
 	TFT_CS_LOW();   // Select the TFT
-	SPI_Transfer(data); // Send byte via SPI
+	TFT_TRANSFER(data); // Send byte via SPI
 	TFT_CS_HIGH();  // De-select TFT
-}
\ No newline at end of file
+}
+
+// Open a data burst: D/C high and CS low until spi_tft_endData()
+void spi_tft_beginData(void)
+{
+	if (!tft_burst)
+	{
+		TFT_WAIT();     // previous burst may still release CS from the ISR
+		TFT_DC_HIGH();  // D/C = 1 for data
+		TFT_CS_LOW();   // Select the TFT
+		tft_burst = 1;
+	}
+}
+
+// Push one data byte, a burst is opened if none is open
+void spi_tft_pushData(uint8_t data)
+{
+	if (!tft_burst)
+		spi_tft_beginData();
+	TFT_WRITE(data);
+}
+
+// Push a block of data bytes in the current burst
+void spi_tft_pushBurst(const uint8_t *buf, uint16_t len)
+{
+	if (!tft_burst)
+		spi_tft_beginData();
+	while (len--)
+		TFT_WRITE(*buf++);
+}
+
+// Close the data burst. CS is released after the last queued byte, with
+// SPI_TX_RING this happens in the background and the call returns at once.
+void spi_tft_endData(void)
+{
+	if (tft_burst)
+	{
+		TFT_WRITE_END();  // De-select TFT
+		tft_burst = 0;
+	}
+}
+
+// Push count copies of a 2 byte unit (one RGB565 pixel) in the current burst
+void spi_tft_pushRepeat(uint8_t hi, uint8_t lo, uint32_t count)
+{
+	if (!tft_burst)
+		spi_tft_beginData();
+	if (tft_usart)
+		USART_SPI_WriteRepeat(hi, lo, count);
+	else
+		SPI_WriteRepeat(hi, lo, count);
+}
+
+// Send a command which is followed by read data (RAMRD etc).
+// The TFT ends a read command when CS goes high, so CS is held low from the
+// command into the read and D/C is set high for the data. The read frame is
+// open until spi_tft_endData() or the next command.
+void spi_tft_readCommand(uint8_t cmd)
+{
+	spi_tft_endData();
+	TFT_WAIT();
+	TFT_DC_LOW();       // D/C = 0 for command
+	TFT_CS_LOW();
+	TFT_TRANSFER(cmd);
+	TFT_DC_HIGH();      // D/C = 1 for the read data, CS stays low
+	tft_burst = 1;
+}
+
+// Read a block of data bytes. The SPI module is polled pr byte, USART1
+// keeps one byte queued in its double buffered UDR so there is no gap
+// between bytes, at the lower USART_SPI_READ_UBRR read clock.
+void spi_tft_readBurst(uint8_t *buf, uint16_t len)
+{
+	if (!tft_burst)
+		spi_tft_beginData();
+	if (tft_usart)
+		USART_SPI_ReadBurst(buf, len);
+	else
+		SPI_ReadBurst(buf, len);
+}
+
+// Read one data byte. D/C is set high and CS is held low until
+// spi_tft_endData() so several bytes can be read in one frame.
+uint8_t spi_tft_readData(void)
+{
+	uint8_t data;
+	spi_tft_readBurst(&data, 1);
+	return data;
+}
+
+// ---------- Display transports (ghwtrans.h) ----------
+
+static void tft_open_hwspi(void)
+{
+	spi_tft_endData();
+	TFT_WAIT();
+	tft_usart = 0;
+	SPCR |= (1<<SPE);  // may have been released by the bit-bang transport
+	TFT_PINS_INIT();
+	TFT_CS_HIGH();
+}
+
+static void tft_open_usartspi(void)
+{
+	spi_tft_endData();
+	TFT_WAIT();
+	tft_usart = 1;
+	init_usart_spi();
+	TFT_PINS_INIT();
+	TFT_CS_HIGH();
+}
+
+const GHW_TRANSPORT ghw_tr_hwspi =
+{
+	tft_open_hwspi,
+	spi_tft_sendCommand,
+	spi_tft_pushData,
+	spi_tft_pushBurst,
+	spi_tft_pushRepeat,
+	spi_tft_readCommand,
+	spi_tft_readData,
+	spi_tft_readBurst,
+	spi_tft_endData
+};
+
+const GHW_TRANSPORT ghw_tr_usartspi =
+{
+	tft_open_usartspi,
+	spi_tft_sendCommand,
+	spi_tft_pushData,
+	spi_tft_pushBurst,
+	spi_tft_pushRepeat,
+	spi_tft_readCommand,
+	spi_tft_readData,
+	spi_tft_readBurst,
+	spi_tft_endData
+};
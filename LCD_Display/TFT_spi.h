@@ -12,9 +12,25 @@
 #include "spi4.h" // basic spi functions
 #include "TFT_spi.h" // req for TFT_DC_INIT
 
+// ---------- Transport ----------
+// Define to drive the TFT from USART1 in Master SPI Mode (usart_spi.c)
+// instead of the SPI module. MOSI/SCK/MISO then go to TXD1 (PD3), XCK1 (PD5)
+// and RXD1 (PD2), which leaves the SPI module to the SD/HV/relay devices.
+// This sets the default, ghw_transport_select() can switch at run time.
+//#define TFT_USART_SPI
+
+// ---------- Port selection ----------
+// Each line is given by its port letter, TFT_IO_PORT() / TFT_IO_DDR() make
+// the register names. ghwxmem.c checks the letters against the XMEM bus
+#define TFT_IO_PORT(io)  TFT_IO_PORT_(io)
+#define TFT_IO_PORT_(io) PORT##io
+#define TFT_IO_DDR(io)   TFT_IO_DDR_(io)
+#define TFT_IO_DDR_(io)  DDR##io
+
 // ---------- Data/Command (D/C) configuration ----------D/C is Command LOW
-#define TFT_SPI_DC_PORT PORTA
-#define TFT_SPI_DC_DDR  DDRA
+#define TFT_SPI_DC_IO   A
+#define TFT_SPI_DC_PORT TFT_IO_PORT(TFT_SPI_DC_IO)
+#define TFT_SPI_DC_DDR  TFT_IO_DDR(TFT_SPI_DC_IO)
 #define TFT_SPI_DC_PIN  0
 #define TFT_SPI_DC_MASK (1 << TFT_SPI_DC_PIN)
 
@@ -27,27 +43,48 @@
 #define TFT_SPI_RST_DDR  DDRE
 #define TFT_SPI_RST_PIN  7
 #define TFT_SPI_RST_MASK (1 << TFT_SPI_RST_PIN)
-#define TFT_RST_LOW()         (TFT_SPI_RST_PORT &= ~TFT_SPI_RST_MASK)  // Active LOW
-#define TFT_RST_HIGH()       (TFT_SPI_CS_PORT |=  TFT_SPI_RST_MASK)  // Inactive HIGH
+#define TFT_RST_LOW()        (TFT_SPI_RST_PORT &= ~TFT_SPI_RST_MASK)  // Active LOW
+#define TFT_RST_HIGH()       (TFT_SPI_RST_PORT |=  TFT_SPI_RST_MASK)  // Inactive HIGH
+// Output, driven high before the DDR is set so the pin does not pulse low
+#define TFT_RST_INIT()       do { if (!(TFT_SPI_RST_DDR & TFT_SPI_RST_MASK)) { TFT_RST_HIGH(); TFT_SPI_RST_DDR |= TFT_SPI_RST_MASK; } } while(0)
 
 // ---------- Chip Select (CS) configuration ----------
-#define TFT_SPI_CS_PORT PORTA //Port for Chip Select
-#define TFT_SPI_CS_DDR  DDRA       // Data Direction Register for Chip Select
+#define TFT_SPI_CS_IO   A //Port for Chip Select
+#define TFT_SPI_CS_PORT TFT_IO_PORT(TFT_SPI_CS_IO)
+#define TFT_SPI_CS_DDR  TFT_IO_DDR(TFT_SPI_CS_IO)  // Data Direction Register for Chip Select
 #define TFT_SPI_CS_PIN  2  // Pin number for Chip Select
 #define TFT_SPI_CS_MASK (1 << TFT_SPI_CS_PIN)  //00000100
 #define TFT_CS_INIT()   (TFT_SPI_CS_DDR |= TFT_SPI_CS_MASK)
-#define TFT_CS_LOW()	(TFT_SPI_CS_PORT &= ~TFT_SPI_DC_MASK) // CS = 0 (selected)
+#define TFT_CS_LOW()	(TFT_SPI_CS_PORT &= ~TFT_SPI_CS_MASK) // CS = 0 (selected)
 #define TFT_CS_HIGH()	(TFT_SPI_CS_PORT |= TFT_SPI_CS_MASK)  //CS = 1 (deselected)
 
 
-#define TFT_PINS_INIT()   do { TFT_CS_INIT(); TFT_DC_INIT(); } while(0) 
+#define TFT_PINS_INIT()   do { TFT_CS_INIT(); TFT_DC_INIT(); TFT_RST_INIT(); } while(0)
 // used in ghwioini.c ------- Initialization helper ----------
 //#define SELECT_CS()         (TFT_SPI_CS_PORT &= ~TFT_SPI_CS_MASK)  // Active LOW
 //#define DESELECT_CS()       (TFT_SPI_CS_PORT |=  TFT_SPI_CS_MASK)  // Inactive HIGH
 
+void spi_tft_init(void); // pins + transport, called from ghw_io_init()
+
 void spi_tft_sendCommand(uint8_t cmd);
 
 // Function to perform SPI communication with the TFT display
 void spi_tft_sendData(uint8_t data);
 
+// Burst data transfer. D/C stays high and CS stays low from the first pushed
+// byte until spi_tft_endData() or the next spi_tft_sendCommand(), so a whole
+// RAMWR payload costs one CS/DC cycle. Call spi_tft_endData() and SPI_Wait()
+// before another device on the SPI bus is selected.
+void spi_tft_beginData(void);
+void spi_tft_pushData(uint8_t data);
+void spi_tft_pushBurst(const uint8_t *buf, uint16_t len);
+void spi_tft_pushRepeat(uint8_t hi, uint8_t lo, uint32_t count); // count x 2 bytes
+void spi_tft_endData(void);
+
+// Read back (GRAM, registers). CS is held low from spi_tft_readCommand()
+// through the read data until spi_tft_endData() or the next command.
+void spi_tft_readCommand(uint8_t cmd);
+uint8_t spi_tft_readData(void);
+void spi_tft_readBurst(uint8_t *buf, uint16_t len);
+
 #endif /* TFT_SPI_H_ */
\ No newline at end of file
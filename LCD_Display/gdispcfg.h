@@ -46,8 +46,14 @@
 ************************************************************/
 
 /* Size of display module in pixels */
+/*#define GHW_PORTRAIT*/ /* HX8357D: use the 320x480 GRAM layout unrotated (see GHW_ROTATED) */
+#ifdef GHW_PORTRAIT
+#define GDISPW 320    /* Width */
+#define GDISPH 480    /* Height */
+#else
 #define GDISPW 480    /* Width */
 #define GDISPH 320    /* Height */
+#endif
 
 #define GDISPCW 8 // built-in font char width in HW LCD, 8,7,6,5 pg 20
 
@@ -60,13 +66,14 @@
 /*#define GHW_HX8325_CMDINTF */ /* Using HX8325 (320x240) or SPFD54126 command interface mode */
 /*#define GHW_HX8352B */        /* Using HX8352B (240x320)(240x400)(240x442) or HX8367A (240x320) register index interface */
 /*#define GHW_HX8353_CMDINTF */ /* Using HX8353 (132x162) or ST7773 */
-#define GHW_HX8353D_CMDINTF // Using HX8353D (132x162) as per email 
+/*#define GHW_HX8353D_CMDINTF*/ /* Using HX8353D (132x162) */
 /*#define GHW_SSD1355*/         /* Using SSD1355 (128x160) */
 /*#define GHW_ST7628 */         /* Using ST7628  (98x70) */
 //#define GHW_ILI9163             /* Using ILI9163 (132x160), NT39122, ILI9340, ILI9341 (240x320), ILI9342 (320x240), ST7715 (132x132), ST7735 (132x162), ST7773 (176x122), ST7789C (240x320) */
 /*#define GHW_ILI9341V */       /* Using ILI9341V (240x320) (ILI9341V behave like ILI9163, except for read back in 16 bit bus mode)*/
 /*#define GHW_HX8369*/          /* Using HX8369-A (480x864), HX8368-A (320x240) - command interface mode */
 /*#define GHW_ILI9488*/         /* Using ILI9488 (320x480),ILI9327(240x432), ILI9486L (320x480). command interface mode */
+#define GHW_HX8357D            /* Using HX8357D (320x480) command interface mode */
 
 
 /* Define display controller bus size (select only one).
@@ -134,6 +141,33 @@
    instead of using a (faster) static buffer */
 #ifdef GBUFFER
   /* #define GHW_ALLOCATE_BUF */ /* Allocate buffer on heap */
+  #define GHW_DIRTY_RECTS 4      /* Dirty areas tracked separately by ghw_updatehw(), more areas
+                                    are flushed as one bounding box (ghwbuf.c) */
+  /* #define GHW_DIRTY_TILES */  /* Track dirty 16x16 pixel tiles in a bitmap instead, each run of
+                                    dirty tiles in a tile row is flushed as one window */
+  /* #define GHW_INDEXED_BUF 4 */ /* Buffer palette indices of 4 or 8 bit pr pixel instead of colors,
+                                    expanded by ghw_updatehw() (ghwibuf.c). 4: the 16 palette colors
+                                    only, 8: 16 palette colors + 240 colors assigned when drawn.
+                                    75 KB / 150 KB for 480x320, needs GHW_XMEM_BUF on the AVR */
+  /* #define GHW_XMEM_BUF */      /* Buffer in bank switched external SRAM (ATmega2560 XMEM, upper
+                                    32 KB window, bank latch on PORTL), see ghwxmem.c. Holds the
+                                    palette indices with GHW_INDEXED_BUF. PORTA / PORTC become the
+                                    XMEM bus, the TFT D/C and CS lines must be on other ports */
+  /* #define GHW_ROW_HASH 160 */  /* Keep a hash of each row segment of 160 pixels as flushed, whole
+                                    segments which are unchanged are skipped by ghw_updatehw(), ex
+                                    at ghw_flush_all(). RAM: 2 bytes pr segment, GDISPH*ceil(GDISPW/
+                                    GHW_ROW_HASH)*2, so 1920 bytes for GDISPW 480 x GDISPH 320, in an
+                                    XMEM bank of its own with GHW_XMEM_BUF. A 16 bit hash collision
+                                    (about 1 in 65536 changes) skips a changed segment, see
+                                    GHW_ROW_HASH_REFRESH */
+  /* #define GHW_ROW_HASH_REFRESH 16 */ /* Each flush writes 1 of 16 rows without the hash compare, so a
+                                    skipped segment is fixed within 16 full screen flushes. Lower is
+                                    safer, higher writes less (default 16, 1..255) */
+#else
+  /* Band rendering without a frame buffer (ghwband.c). The drawing between ghw_band_begin() and
+     ghw_band_end() is composed GHW_BAND_ROWS rows at a time and written without read back */
+  /* #define GHW_BAND_ROWS 4 */   /* Rows pr band, the band buffer is GHW_BAND_ROWS*GDISPW*2 bytes */
+  /* #define GHW_BAND_LIST 512 */ /* Display list size in bytes */
 #endif
 
 /* If GWARNING is defined, illegal runtime values will cause
@@ -193,10 +227,22 @@
    #define GCONSTP const
    /* type qualifier used for fixed data (graphic tables etc) */
    #define GCODE  const
+   #if (defined( __GNUC__ ) && defined( __FLASH ))
+   /* avr-gcc named address space: the fonts (GCLCD/fonts), SYSFONT, the
+      palette and sympixmsk are located in flash only, and reads via FCODE /
+      PFCODE qualified objects and pointers (PGSYMBOL, PGSYMBYTE, PGCSTR,
+      PGCODEPAGE) are compiled to LPM. Symbols in RAM (ex read back with
+      ghw_rdsym()) must then be written with ghw_wrsym_ram() */
+   /* Memory type qualifier used for fixed data (if GCODE setting is not enough) */
+   #define FCODE  __flash
+   /* Memory type qualifier used for pointer to fixed data (if GCODE var * is not enough) */
+   #define PFCODE __flash
+   #else
    /* Memory type qualifier used for fixed data (if GCODE setting is not enough) */
    #define FCODE  /* nothing */
    /* Memory type qualifier used for pointer to fixed data (if GCODE var * is not enough) */
    #define PFCODE /* nothing */
+   #endif
    /* Keyword used for generic pointers to data strings, if generic pointers is not default */
    #define PGENERIC /* nothing */
 #endif
@@ -229,7 +275,11 @@
 /*#define GHW_MIRROR_HOR*/ /* Mirror the display horizontally */
  #define GHW_XOFFSET  0    /* Set display x start offset in on-chip video ram */
  #define GHW_YOFFSET  0    /* Set display y start offset in on-chip video ram */
-/*#define GHW_ROTATED */   /* Define to rotate display 90 (270) degrees (remember to swap values used in GDISPH,GDISPW definitions) */
+#ifndef GHW_PORTRAIT
+ #define GHW_ROTATED      /* Define to rotate display 90 (270) degrees (remember to swap values used in GDISPH,GDISPW definitions) */
+                  /* HX8357D: the GRAM is 320x480, the 480x320 display uses MADCTL 0xA8 (MY, MV, BGR).
+                     GHW_PORTRAIT selects 320x480 with MADCTL 0x88 (MY, BGR) instead */
+#endif
  #define GHW_COLOR_SWAP    /* Define to change R,G,B order to B,G,R order */
  #define GHW_COMSPLIT      /* Define to used split COM line controls (SSD1355) */
 
@@ -244,6 +294,24 @@
 /*#define GHW_NO_LCD_READ_SUPPORT*/ /* Use reduced feature set where read-write,
                                        read-modify-write operations not allowed */
 
+ #define GHW_USE_TRANSPORT /* Controller is accessed via a display transport (ghwtrans.h)
+                              Data bytes are streamed in bursts with CS held low */
+ #define GHW_WINDOW_CACHE  /* Only send the CASET / RASET part which differs from the
+                              last window set (see ghw_win_invalidate()) */
+ #define GHW_WRITE_COMBINE /* Append writes which continue at the controller address counter
+                              to the open RAMWR stream instead of setting a new window */
+#define GHW_RMW_CHUNK 64  /* Pixels pr read-modify-write chunk in ghw_gscroll() and ghw_invert()
+                             (non-buffered mode). The chunk buffer uses GHW_RMW_CHUNK*2 bytes RAM.
+                             Each chunk costs two window settings and a RAMRD dummy read */
+/*#define GHW_STATS*/      /* Count bus bytes, CS / DC activity, windows and pixels pr
+                              driver entry point (ghwstats.h) */
+/*#define GHW_TRACE*/      /* Record the command / data stream for offline analysis
+                              (ghwtrace.h, host/ghwtrcan.c) */
+/*#define GHW_HW_SCROLL*/  /* ghw_gscroll() of full width areas with the HX8357D vertical
+                              scroll (VSCRDEF / VSCRSADD), only the exposed lines are written.
+                              The controller scrolls GRAM rows, which are display columns with
+                              GHW_ROTATED, so there ghw_gscroll() keeps using read back */
+
 /****************** COLOR DEFINITION *******************/
 /* Enable code generation for color and gray-shade support */
 #define GHW_USING_COLOR
@@ -0,0 +1,112 @@
+#ifndef GHWSCRIPT_H
+#define GHWSCRIPT_H
+/***************************** ghwscript.h ********************************
+
+   Display controller initialization script format.
+
+   A script is a flash resident byte table executed one entry at a time by
+   ghw_script_step() (ghwinit.c). Used for the controller configuration
+   table (as1dregs in ghwinit.c) and the module start-up table
+   (hx8357d_init in hx8375d.c).
+
+   The tables are declared with GSCR_FLASH and only read via GSCR_RD().
+   With avr-gcc they are placed in flash (PROGMEM) and read with LPM,
+   elsewhere GSCR_RD() is a plain read. The tables do not depend on the
+   FCODE setting in gdispcfg.h, so they are in flash with any avr-gcc.
+
+   Entry layout:
+      ctl, cmd, arg[0] .. arg[n-1] [, wait]
+
+      ctl bit 0-5  Number of argument bytes n (0-63)
+      ctl bit 6    Continuation, the cmd byte is left out and the
+                   arguments continue the parameter list of the previous
+                   entry. Used for parameter lists longer than 63 bytes.
+      ctl bit 7    A wait byte follows the arguments.
+                   The wait is in units of 5 ms (5 - 1275 ms)
+   The table is terminated by GSCR_END (a continuation without arguments).
+
+   The entries are written with the macros below. The argument count is
+   computed by the compiler, and the count and wait limits are checked at
+   compile time.
+
+      GSCR_CMD0(cmd)                     Command without arguments
+      GSCR_CMD0_WAIT(cmd, ms)            Command, then wait ms
+      GSCR_CMD(cmd, arg, ...)            Command with 1-63 argument bytes
+      GSCR_CMD_WAIT(cmd, ms, arg, ...)   Command with arguments, then wait ms
+      GSCR_DAT(arg, ...)                 1-63 more argument bytes for the
+                                         previous command
+      GSCR_DAT_WAIT(ms, arg, ...)        More argument bytes, then wait ms
+      GSCR_REG(index, value)             Register index interface write
+      GSCR_REG_WAIT(index, ms, value)    Register write, then wait ms
+      GSCR_END                           End of table
+
+   The arguments of a command, including continuation entries, are sent
+   as one burst (the bus is not released between the argument bytes).
+
+   Example:
+      static GCODE SGUCHAR GSCR_FLASH myinit[] =
+         {
+         GSCR_CMD0_WAIT(0x11, 150),        // Sleep out
+         GSCR_CMD(0x3A, 0x55),             // 16 bit color
+         GSCR_CMD(0xB3, 0x00, 0x00, 0x06, 0x06),   // Frame rate
+         GSCR_END
+         };
+
+*********************************************************************/
+
+#include <gdisphw.h>   /* GCODE, SGUCHAR */
+
+#if (defined( __AVR__ ) && !defined( GHW_PCSIM ))
+   #include <avr/pgmspace.h>
+   #define GSCR_FLASH  PROGMEM
+   #define GSCR_RD(p)  ((SGUCHAR) pgm_read_byte(p))
+#else
+   #define GSCR_FLASH  /* nothing */
+   #define GSCR_RD(p)  (*(p))
+#endif
+
+#define GSCR_WAITFLAG  0x80
+#define GSCR_DATFLAG   0x40
+#define GSCR_NARGMSK   0x3F
+#define GSCR_MAXARGS   63
+#define GSCR_MAXWAIT   (255*5)
+
+/* ghw_script_step() return value at GSCR_END */
+#define GSCR_DONE      0xFFFF
+
+/* Evaluates to 0 if cond is true, fails compilation otherwise */
+#define GSCR_CHECK(cond) (0*sizeof(char[(cond) ? 1 : -1]))
+
+/* Number of macro arguments. Counted as the size of a byte array holding
+   them, so there is no upper limit where the count goes wrong, a list
+   longer than GSCR_MAXARGS fails the check in GSCR_CTL() */
+#define GSCR_NARG(...) (sizeof((SGUCHAR[]){ __VA_ARGS__ }))
+
+/* Control byte and wait byte */
+#define GSCR_CTL(n,f)  ((SGUCHAR)(((n) | (f)) + GSCR_CHECK(((n) > 0 || !((f) & GSCR_DATFLAG)) && ((n) <= GSCR_MAXARGS))))
+#define GSCR_MS(ms)    ((SGUCHAR)(((ms)+4)/5 + GSCR_CHECK(((ms) > 0) && ((ms) <= GSCR_MAXWAIT))))
+
+#define GSCR_CMD0(cmd)                 GSCR_CTL(0,0), (cmd)
+#define GSCR_CMD0_WAIT(cmd,ms)         GSCR_CTL(0,GSCR_WAITFLAG), (cmd), GSCR_MS(ms)
+#define GSCR_CMD(cmd, ...)             GSCR_CTL(GSCR_NARG(__VA_ARGS__),0), (cmd), __VA_ARGS__
+#define GSCR_CMD_WAIT(cmd, ms, ...)    GSCR_CTL(GSCR_NARG(__VA_ARGS__),GSCR_WAITFLAG), (cmd), __VA_ARGS__, GSCR_MS(ms)
+#define GSCR_DAT(...)                  GSCR_CTL(GSCR_NARG(__VA_ARGS__),GSCR_DATFLAG), __VA_ARGS__
+#define GSCR_DAT_WAIT(ms, ...)         GSCR_CTL(GSCR_NARG(__VA_ARGS__),GSCR_DATFLAG|GSCR_WAITFLAG), __VA_ARGS__, GSCR_MS(ms)
+#define GSCR_REG(index,value)          GSCR_CMD(index,value)
+#define GSCR_REG_WAIT(index,ms,value)  GSCR_CMD_WAIT(index,ms,value)
+#define GSCR_END                       GSCR_DATFLAG
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Execute the script entry at *script and advance *script to the next
+   entry. Returns the wait in ms requested by the entry (0 = none),
+   or GSCR_DONE at the end of the table */
+SGUINT ghw_script_step(GCODE SGUCHAR **script);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GHWSCRIPT_H */
@@ -0,0 +1,120 @@
+#ifndef GHWSTATS_H
+#define GHWSTATS_H
+/***************************** ghwstats.h ********************************
+
+   Display bus cost counters (compile time option GHW_STATS in gdispcfg.h)
+
+   The counters are kept pr driver entry point. Each counted ghw_ function
+   makes itself the current entry point when called, and all bus traffic
+   and pixel operations are added to the current entry point until the
+   next counted function is called.
+
+   Counters:
+      calls       Calls of the entry point
+      cmd_bytes   Command bytes (D/C low)
+      data_bytes  Parameter and pixel bytes written (D/C high)
+      read_bytes  Bytes read
+      cs_assert   CS assertions. CS is asserted for each command byte and
+                  when a data burst is opened after a command or a flush.
+      dc_toggle   Changes of the D/C line level
+      windows     ghw_set_xyrange() calls (including calls where the
+                  window cache or write combining made no bus access)
+      pix_wr      Pixels written
+      pix_rd      Pixels read
+      rd_turn     Read back turnarounds (RAMRD commands)
+
+   The bus counters are made by a counting layer in front of the active
+   transport (GHW_USE_TRANSPORT), so the result is the same for all
+   transports, also for the mock transport in the host build.
+
+   Use:
+      GHW_STATCNT st;
+      ghw_stats_reset();
+      ... draw ...
+      ghw_stats_get(GHW_STAT_FILL, &st);   // One entry point
+      ghw_stats_get(GHW_STAT_ALL, &st);    // Sum of all entry points
+
+*********************************************************************/
+
+#include <gdisphw.h>   /* SGUCHAR, SGULONG, gdispcfg.h */
+
+/* Entry points */
+#define GHW_STAT_OTHER      0   /* Not attributed to an entry point below */
+#define GHW_STAT_INIT       1   /* ghw_init(), ghw_init_start(), ghw_init_poll() */
+#define GHW_STAT_FILL       2   /* ghw_fill() */
+#define GHW_STAT_WRSYM      3   /* ghw_wrsym() */
+#define GHW_STAT_RDSYM      4   /* ghw_rdsym() */
+#define GHW_STAT_RECTANGLE  5   /* ghw_rectangle() */
+#define GHW_STAT_UPDATEHW   6   /* ghw_updatehw(), ghw_flush_all() */
+#define GHW_STAT_GSCROLL    7   /* ghw_gscroll() */
+#define GHW_STAT_INVERT     8   /* ghw_invert() */
+#define GHW_STAT_WRBLK      9   /* ghw_wrblk(), ghw_restoreblk() */
+#define GHW_STAT_RDBLK     10   /* ghw_rdblk() */
+#define GHW_STAT_SETPIXEL  11   /* ghw_setpixel() */
+#define GHW_STAT_GETPIXEL  12   /* ghw_getpixel() */
+#define GHW_STAT_ENTRIES   13
+#define GHW_STAT_ALL     0xff   /* ghw_stats_get() sum of all entry points */
+
+/* Entry point names, for use in an initializer:
+   static const char *names[GHW_STAT_ENTRIES] = GHW_STAT_NAMES; */
+#define GHW_STAT_NAMES \
+   { "other", "init", "fill", "wrsym", "rdsym", "rectangle", "updatehw", \
+     "gscroll", "invert", "wrblk", "rdblk", "setpixel", "getpixel" }
+
+typedef struct
+   {
+   SGULONG calls;
+   SGULONG cmd_bytes;
+   SGULONG data_bytes;
+   SGULONG read_bytes;
+   SGULONG cs_assert;
+   SGULONG dc_toggle;
+   SGULONG windows;
+   SGULONG pix_wr;
+   SGULONG pix_rd;
+   SGULONG rd_turn;
+   } GHW_STATCNT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef GHW_STATS
+
+extern GHW_STATCNT ghw_stats_tab[GHW_STAT_ENTRIES];
+extern SGUCHAR ghw_stats_entry;
+
+void ghw_stats_reset(void);
+void ghw_stats_get(SGUCHAR entry, GHW_STATCNT *st);
+
+/* Counting used by the driver modules */
+#define GHW_STATS_ENTRY(id) \
+   do { ghw_stats_entry = (id); ghw_stats_tab[(id)].calls++; } while(0)
+#define GHW_STATS_ADD(cnt,n)  (ghw_stats_tab[ghw_stats_entry].cnt += (n))
+#define GHW_STATS_INC(cnt)    (ghw_stats_tab[ghw_stats_entry].cnt++)
+
+#if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+#include <ghwtrans.h>
+/* Counting layer, forwards to the active transport ghw_tr */
+extern const GHW_TRANSPORT ghw_tr_stats;
+#define GHW_TR (&ghw_tr_stats)
+#endif
+
+#else  /* GHW_STATS */
+
+#define GHW_STATS_ENTRY(id)   do { } while(0)
+#define GHW_STATS_ADD(cnt,n)  do { } while(0)
+#define GHW_STATS_INC(cnt)    do { } while(0)
+
+#endif /* GHW_STATS */
+
+/* Transport used by the driver */
+#ifndef GHW_TR
+#define GHW_TR ghw_tr
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GHWSTATS_H */
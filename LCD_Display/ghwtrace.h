@@ -0,0 +1,88 @@
+#ifndef GHWTRACE_H
+#define GHWTRACE_H
+/***************************** ghwtrace.h ********************************
+
+   Display bus trace recorder (compile time option GHW_TRACE in gdispcfg.h)
+
+   The recorder is a transport layer (ghwtrans.h) placed in front of the
+   active transport with ghw_trace_start(). It records the exact command
+   and data stream sent to the controller as a sequence of records:
+
+      GHW_TRC_CMD     tag, cmd                    Command byte
+      GHW_TRC_DATA    tag, dat                    Data byte
+      GHW_TRC_BURST   tag, n, dat[n]              n data bytes (1 - GHW_TRC_BURST_MAX)
+      GHW_TRC_REPEAT  tag, hi, lo, count (32 bit, lsb first)
+                                                  count copies of hi,lo
+      GHW_TRC_READ    tag, dat                    Data byte read
+      GHW_TRC_FLUSH   tag                         Transport flush
+      GHW_TRC_FRAME   tag                         Frame end, ghw_trace_frame()
+
+   Without a sink the records are kept in a RAM ring of GHW_TRACE_SIZE
+   bytes, where the oldest records are dropped when the ring is full.
+   The ring is emptied with ghw_trace_read(), e.g. to send it to a PC via
+   a serial port. With a sink (host build) each record is passed on
+   directly, e.g. to be written to a file.
+
+   The recorded stream is analysed on the PC with host/ghwtrcan.c.
+
+   Use:
+      ghw_trace_start();        // After the transport is selected
+      ... draw ...
+      ghw_trace_frame();        // Mark the end of a screen update
+      ghw_trace_stop();
+
+   ghw_trace_frame() may be left in the application code, it is empty when
+   GHW_TRACE is not defined.
+
+*********************************************************************/
+
+#include <stdint.h>
+
+/* Record tags */
+#define GHW_TRC_CMD      0x01
+#define GHW_TRC_DATA     0x02
+#define GHW_TRC_BURST    0x03
+#define GHW_TRC_REPEAT   0x04
+#define GHW_TRC_READ     0x05
+#define GHW_TRC_FLUSH    0x06
+#define GHW_TRC_FRAME    0x07
+
+/* Max data bytes in a GHW_TRC_BURST record (longer bursts are split) */
+#define GHW_TRC_BURST_MAX  32
+/* Max record size */
+#define GHW_TRC_REC_MAX    (2+GHW_TRC_BURST_MAX)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef GHW_TRACE
+
+#ifndef GHW_TRACE_SIZE
+  #define GHW_TRACE_SIZE 512   /* RAM ring size in bytes */
+#endif
+
+/* Receives each record instead of the RAM ring, if set */
+extern void (*ghw_trace_sink)(const uint8_t *rec, uint8_t len);
+/* Number of records dropped from the RAM ring */
+extern uint16_t ghw_trace_lost;
+
+void ghw_trace_start(void);
+void ghw_trace_stop(void);
+void ghw_trace_frame(void);
+
+/* Move the oldest whole records from the RAM ring to buf.
+   Returns the number of bytes copied */
+uint16_t ghw_trace_read(uint8_t *buf, uint16_t size);
+
+#else  /* GHW_TRACE */
+
+#define ghw_trace_frame()  do { } while(0)
+
+#endif /* GHW_TRACE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GHWTRACE_H */
@@ -0,0 +1,83 @@
+#ifndef GHWTRANS_H
+#define GHWTRANS_H
+/***************************** ghwtrans.h ********************************
+
+   Display bus transport interface.
+
+   The display driver (ghwinit.c) reaches the controller only through the
+   transport selected here, so the bus can be exchanged or benchmarked
+   without modifying the driver.
+
+   Each transport implements:
+      open          Set up pins and peripheral, called by ghw_transport_select()
+      write_cmd     Command byte (D/C low). Ends an open data burst
+      write_data    Parameter or pixel byte (D/C high). Opens a burst if needed
+      write_burst   Block of data bytes in the current burst
+      write_repeat  count copies of a 2 byte unit (one RGB565 pixel)
+      read_cmd      Command byte followed by read data. The serial transports
+                    keep CS low from the command into the read, as the
+                    controller ends a read command when CS goes high
+      read_data     Read a data byte
+      read_burst    Read a block of data bytes
+      flush         Fence: complete all pending writes and release the bus
+
+   Available transports:
+      ghw_tr_hwspi     SPI module (TFT_spi.c, spi4.c)
+      ghw_tr_usartspi  USART1 in master SPI mode (TFT_spi.c, usart_spi.c)
+      ghw_tr_bitbang   Software SPI on the SPI module pins (ghwtrans.c)
+      ghw_tr_parallel  8 bit 8080 bus via simwrby()/simrdby() (bussim.c)
+      ghw_tr_mock      No hardware, counts and forwards bytes to a hook
+
+*********************************************************************/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+   {
+   void    (*open)(void);
+   void    (*write_cmd)(uint8_t cmd);
+   void    (*write_data)(uint8_t dat);
+   void    (*write_burst)(const uint8_t *buf, uint16_t len);
+   void    (*write_repeat)(uint8_t hi, uint8_t lo, uint32_t count);
+   void    (*read_cmd)(uint8_t cmd);
+   uint8_t (*read_data)(void);
+   void    (*read_burst)(uint8_t *buf, uint16_t len);
+   void    (*flush)(void);
+   } GHW_TRANSPORT;
+
+/* Active transport */
+extern const GHW_TRANSPORT *ghw_tr;
+void ghw_transport_select(const GHW_TRANSPORT *tr);
+
+#ifdef __AVR__
+extern const GHW_TRANSPORT ghw_tr_hwspi;
+extern const GHW_TRANSPORT ghw_tr_usartspi;
+extern const GHW_TRANSPORT ghw_tr_bitbang;
+#endif
+#ifdef GHW_SINGLE_CHIP
+extern const GHW_TRANSPORT ghw_tr_parallel;
+#endif
+extern const GHW_TRANSPORT ghw_tr_mock;
+
+/* Mock transport byte counters and hooks */
+typedef struct
+   {
+   uint32_t cmds;     /* Command bytes */
+   uint32_t data;     /* Data bytes written */
+   uint32_t reads;    /* Data bytes read */
+   uint32_t flushes;  /* Flush calls */
+   } GHW_TR_MOCKSTAT;
+
+extern GHW_TR_MOCKSTAT ghw_tr_mockstat;
+extern void (*ghw_tr_mock_sink)(uint8_t isdata, uint8_t dat); /* Receives every byte written, if set */
+extern uint8_t (*ghw_tr_mock_source)(void);                  /* Supplies read data, if set */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GHWTRANS_H */
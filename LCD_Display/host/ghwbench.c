@@ -0,0 +1,381 @@
+/***************************** ghwbench.c ************************************
+
+   Display driver benchmark (host build, see Makefile)
+
+   Canned workloads are run through the driver with the mock transport
+   and the HX8357D emulator. The bus traffic pr frame is taken from the
+   ghw_stats counters (ghwstats.h) and converted to a modelled transfer
+   time for the given SPI clock:
+
+      time = (command + data + read bytes) * 8 / sck + CS assertions * tcs
+
+   where tcs is the software overhead of a CS / D/C cycle on the target.
+
+   Each workload is compared with a stored baseline. The program returns
+   1 if a workload uses more bytes or more modelled time pr frame than the
+   baseline plus the tolerance, so regressions in the driver are caught.
+   A workload without a baseline in the file also fails. If the baseline
+   file does not exist, the first run writes it as with -u, so make bench
+   works on a fresh checkout. Commit the file to keep the baseline.
+
+   Usage:
+      ghwbench [-s sck_hz] [-c tcs_ns] [-t tolerance_pct]
+               [-b baseline_file] [-u] [-o image_dir]
+
+      -s  SPI clock (default 1000000, fck/16 of the SPI port (spi4.c)
+          at F_CPU = 16 MHz, use 8000000 for the USART SPI transport)
+      -c  Cost of one CS assertion in ns (default 1000)
+      -t  Allowed increase in percent (default 1)
+      -b  Baseline file (default bench_baseline.txt)
+      -u  Write the results as the new baseline
+      -o  Save the final image of each workload in image_dir (PNG)
+
+   Baseline file: one line pr workload
+      <workload> <bytes pr frame> <us pr frame>
+
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gdisp.h>
+#include "ghwtrans.h"
+#include "ghwstats.h"
+#include "hx8357emu.h"
+#include "hostview.h"
+
+#ifndef GHW_STATS
+  #error ghwbench requires GHW_STATS (compile with -DGHW_STATS=)
+#endif
+
+typedef struct
+   {
+   const char *name;
+   void (*setup)(void);        /* Screen preparation, not measured */
+   void (*frame)(SGUINT n);    /* One measured frame */
+   SGUINT frames;
+   } BENCH;
+
+typedef struct
+   {
+   double bytes;               /* Bytes on the wire pr frame */
+   double us;                  /* Modelled time pr frame */
+   double cs;                  /* CS assertions pr frame */
+   double windows;             /* ghw_set_xyrange() calls pr frame */
+   } BENCH_RESULT;
+
+static double bench_sck = 1000000.0;
+static double bench_tcs = 1000.0;
+static double bench_tol = 1.0;
+
+/* Deterministic pseudo random sequence (same on all hosts) */
+static SGULONG bench_seed;
+static SGUINT bench_rand(void)
+   {
+   bench_seed = bench_seed * 1103515245UL + 12345UL;
+   return (SGUINT)((bench_seed >> 16) & 0x7fff);
+   }
+
+/********************* Workloads *********************/
+
+static void bench_clear_setup(void)
+   {
+   gsetcolorb(G_WHITE);
+   gsetcolorf(G_BLACK);
+   gclrvp();
+   }
+
+/* Full screen clear */
+static void bench_clear(SGUINT n)
+   {
+   gsetcolorb((n & 1) ? G_BLACK : G_WHITE);
+   gclrvp();
+   }
+
+/* Status page with mixed fonts */
+static void bench_text(SGUINT n)
+   {
+   char buf[48];
+   GYT y;
+   SGUCHAR i;
+   gsetcolorb(G_WHITE);
+   gsetcolorf(G_BLACK);
+   gclrvp();
+   gselfont(&ariel18);
+   gsetpos(4, 20);
+   gputs("System status");
+   gselfont(&ariel9);
+   for (i = 0, y = 44; i < 10; i++, y += 14)
+      {
+      sprintf(buf, "Channel %2u   level %4u   state %s", (unsigned) i,
+         (unsigned)((n * 37 + i * 113) % 1000), ((n + i) & 1) ? "on " : "off");
+      gsetpos(4, y);
+      gputs(buf);
+      }
+   gselfont(&SYSFONT);
+   for (i = 0; i < 6; i++, y += 10)
+      {
+      sprintf(buf, "Log %04u: event %u", (unsigned)(n * 6 + i), (unsigned) bench_rand() % 100);
+      gsetpos(4, y);
+      gputs(buf);
+      }
+   }
+
+static void bench_numeric_setup(void)
+   {
+   bench_clear_setup();
+   gselfont(&ariel9);
+   gsetpos(40, 120);
+   gputs("Output voltage");
+   }
+
+/* Numeric readout refresh, only the value field is redrawn */
+static void bench_numeric(SGUINT n)
+   {
+   char buf[16];
+   SGUINT v = (SGUINT)(1200 + (bench_rand() % 200));
+   sprintf(buf, "%3u.%02u V", v / 100, v % 100);
+   gselfont(&ariel18);
+   gsetpos(200, 140);
+   gputs(buf);
+   (void) n;
+   }
+
+#define CHART_Y0  60
+#define CHART_H   200
+static GYT bench_chart_y;
+
+static void bench_chart_setup(void)
+   {
+   bench_clear_setup();
+   gsetcolorf(G_BLACK);
+   grectangle(0, CHART_Y0-1, GDISPW-1, CHART_Y0+CHART_H);
+   bench_chart_y = CHART_Y0 + CHART_H/2;
+   }
+
+/* Strip chart, one new sample column pr frame with a cleared cursor gap */
+static void bench_chart(SGUINT n)
+   {
+   GXT x = (GXT)(1 + (n % (GDISPW-4)));
+   GYT y = (GYT)(CHART_Y0 + (bench_rand() % CHART_H));
+   gsetcolorb(G_WHITE);
+   gfillvp(x, CHART_Y0, x+2, CHART_Y0+CHART_H-1, 0x0000);
+   gsetcolorf(G_BLUE);
+   gmoveto(x, bench_chart_y);
+   glineto(x, y);
+   bench_chart_y = y;
+   }
+
+#define POP_X0 140
+#define POP_Y0 100
+#define POP_X1 339
+#define POP_Y1 219
+static SGUCHAR bench_blk[((POP_X1-POP_X0+1)*(POP_Y1-POP_Y0+1))*sizeof(GCOLOR)+64];
+
+static void bench_popup_setup(void)
+   {
+   bench_text(0);
+   }
+
+/* Popup with save and restore of the background */
+static void bench_popup(SGUINT n)
+   {
+   ghw_rdblk(POP_X0, POP_Y0, POP_X1, POP_Y1, bench_blk, sizeof(bench_blk));
+   gsetcolorb(G_YELLOW);
+   gsetcolorf(G_BLACK);
+   gfillvp(POP_X0, POP_Y0, POP_X1, POP_Y1, 0x0000);
+   grectangle(POP_X0, POP_Y0, POP_X1, POP_Y1);
+   gselfont(&ariel9);
+   gsetpos(POP_X0+10, POP_Y0+30);
+   gputs((n & 1) ? "Warning: limit reached" : "Press OK to continue");
+   ghw_wrblk(POP_X0, POP_Y0, POP_X1, POP_Y1, bench_blk);
+   }
+
+static void bench_scroll_setup(void)
+   {
+   bench_text(0);
+   }
+
+/* Terminal style scroll with a new line at the bottom */
+static void bench_scroll(SGUINT n)
+   {
+   char buf[32];
+   ghw_gscroll(0, 0, GDISPW-1, GDISPH-1, 10, 0x0000);
+   gselfont(&SYSFONT);
+   sprintf(buf, "Line %u", (unsigned) n);
+   gsetpos(4, GDISPH-2);
+   gputs(buf);
+   }
+
+static const BENCH bench_tab[] =
+   {
+   {"clear",   bench_clear_setup,   bench_clear,     4},
+   {"text",    bench_clear_setup,   bench_text,      4},
+   {"numeric", bench_numeric_setup, bench_numeric,  50},
+   {"chart",   bench_chart_setup,   bench_chart,   476},
+   {"popup",   bench_popup_setup,   bench_popup,     8},
+   {"scroll",  bench_scroll_setup,  bench_scroll,   16}
+   };
+
+#define BENCH_NUM (sizeof(bench_tab)/sizeof(bench_tab[0]))
+
+/********************* Measurement *********************/
+
+static void bench_run(const BENCH *b, BENCH_RESULT *r)
+   {
+   GHW_STATCNT st;
+   SGUINT n;
+   double bytes;
+
+   bench_seed = 1;
+   b->setup();
+   GHW_TR->flush();
+   ghw_stats_reset();
+   for (n = 0; n < b->frames; n++)
+      b->frame(n);
+   GHW_TR->flush();
+   ghw_stats_get(GHW_STAT_ALL, &st);
+
+   bytes = (double) st.cmd_bytes + (double) st.data_bytes + (double) st.read_bytes;
+   r->bytes = bytes / b->frames;
+   r->cs = ((double) st.cs_assert) / b->frames;
+   r->windows = ((double) st.windows) / b->frames;
+   r->us = (bytes * 8.0 * 1e6 / bench_sck + ((double) st.cs_assert) * bench_tcs / 1000.0) / b->frames;
+   }
+
+/* Find baseline values for name, return 0 if found */
+static int bench_baseline(const char *fname, const char *name, double *bytes, double *us)
+   {
+   FILE *fp;
+   char line[128], bname[32];
+   int ret = -1;
+   if ((fp = fopen(fname, "r")) == NULL)
+      return -1;
+   while (fgets(line, sizeof(line), fp) != NULL)
+      {
+      if ((line[0] == '#') ||
+          (sscanf(line, "%31s %lf %lf", bname, bytes, us) != 3))
+         continue;
+      if (strcmp(bname, name) == 0)
+         {
+         ret = 0;
+         break;
+         }
+      }
+   fclose(fp);
+   return ret;
+   }
+
+int main(int argc, char *argv[])
+   {
+   BENCH_RESULT res[BENCH_NUM];
+   const char *basefile = "bench_baseline.txt";
+   const char *imgdir = NULL;
+   int update = 0;
+   int failed = 0;
+   int i;
+   FILE *fp;
+
+   for (i = 1; i < argc; i++)
+      {
+      if ((strcmp(argv[i], "-s") == 0) && (i+1 < argc))
+         bench_sck = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-c") == 0) && (i+1 < argc))
+         bench_tcs = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-t") == 0) && (i+1 < argc))
+         bench_tol = atof(argv[++i]);
+      else if ((strcmp(argv[i], "-b") == 0) && (i+1 < argc))
+         basefile = argv[++i];
+      else if ((strcmp(argv[i], "-o") == 0) && (i+1 < argc))
+         imgdir = argv[++i];
+      else if (strcmp(argv[i], "-u") == 0)
+         update = 1;
+      else
+         {
+         fprintf(stderr, "Usage: %s [-s sck_hz] [-c tcs_ns] [-t tolerance_pct] [-b baseline] [-u] [-o image_dir]\n", argv[0]);
+         return 2;
+         }
+      }
+
+   if (!update)
+      {
+      if ((fp = fopen(basefile, "r")) == NULL)
+         {
+         printf("No baseline file %s, the results are written as baseline\n", basefile);
+         update = 1;
+         }
+      else
+         fclose(fp);
+      }
+
+   hx8357emu_reset();
+   hx8357emu_attach();
+   if (ginit() != 0)
+      {
+      fprintf(stderr, "ginit failed\n");
+      return 2;
+      }
+
+   printf("SPI clock %.0f Hz, CS cost %.0f ns\n", bench_sck, bench_tcs);
+   printf("%-8s %6s %11s %9s %8s %11s %11s  %s\n",
+      "workload", "frames", "bytes/frm", "cs/frm", "win/frm", "us/frm", "base us", "result");
+
+   for (i = 0; i < (int) BENCH_NUM; i++)
+      {
+      double bbytes, bus;
+      const char *result;
+      bench_run(&bench_tab[i], &res[i]);
+
+      if (imgdir != NULL)
+         {
+         char fname[256];
+         sprintf(fname, "%.200s/%s.png", imgdir, bench_tab[i].name);
+         hx8357emu_save(fname, HOST_VIEW);
+         }
+
+      if (update)
+         {
+         bus = res[i].us;
+         result = "saved";
+         }
+      else if (bench_baseline(basefile, bench_tab[i].name, &bbytes, &bus) != 0)
+         {
+         bus = 0;
+         result = "NO BASELINE";
+         failed = 1;
+         }
+      else if ((res[i].bytes > bbytes * (1.0 + bench_tol/100.0)) ||
+               (res[i].us > bus * (1.0 + bench_tol/100.0)))
+         {
+         result = "REGRESSION";
+         failed = 1;
+         }
+      else if (res[i].us < bus * (1.0 - bench_tol/100.0))
+         result = "improved";
+      else
+         result = "ok";
+
+      printf("%-8s %6u %11.0f %9.1f %8.1f %11.1f %11.1f  %s\n",
+         bench_tab[i].name, (unsigned) bench_tab[i].frames, res[i].bytes,
+         res[i].cs, res[i].windows, res[i].us, bus, result);
+      }
+
+   if (update)
+      {
+      if ((fp = fopen(basefile, "w")) == NULL)
+         {
+         fprintf(stderr, "Cannot write %s\n", basefile);
+         return 2;
+         }
+      fprintf(fp, "# ghwbench baseline: workload, bytes pr frame, us pr frame\n");
+      fprintf(fp, "# SPI clock %.0f Hz, CS cost %.0f ns\n", bench_sck, bench_tcs);
+      for (i = 0; i < (int) BENCH_NUM; i++)
+         fprintf(fp, "%s %.1f %.1f\n", bench_tab[i].name, res[i].bytes, res[i].us);
+      fclose(fp);
+      printf("Baseline written to %s\n", basefile);
+      }
+   else if (failed)
+      printf("Failed, a missing baseline is created with -u (make bench-baseline)\n");
+
+   gexit();
+   return failed;
+   }
@@ -0,0 +1,591 @@
+/***************************** ghwtest.c ************************************
+
+   Pixel exact regression test of the display driver (host build, see
+   Makefile)
+
+   Each scene draws a fixed sequence with the driver entry points
+   (ghw_fill, ghw_rectangle, ghw_setpixel, ghw_invert, ghw_gscroll,
+   ghw_wrsym, ghw_rdblk / ghw_wrblk) through the mock transport to the
+   HX8357D emulator. The emulated display is then compared pixel by pixel
+   with the golden image of the scene, and ghw_getpixel() is compared with
+   the display, so a frame buffer which differs from the display is found
+   too.
+
+   Only the driver is used, so the images do not depend on the RAMTEX
+   library. All colors are taken from a test palette with 0x00 / 0xff
+   components, which every buffer variant (ex GHW_INDEXED_BUF) stores
+   exactly. The build variants in the Makefile (TEST_VARIANTS) therefore
+   all have to reproduce the same golden images, which makes the test an
+   equivalence test of the variants as well.
+
+   With TEST_STEP the buffer is flushed with ghw_updatehw_step(TEST_STEP)
+   between the drawing calls, each step must write at most TEST_STEP
+   pixels.
+
+   The delay scene draws with ghw_setupdate(0), so only the steps (with
+   TEST_STEP) write to the display until ghw_setupdate(1) completes the
+   flush.
+
+   Usage:
+      ghwtest [-g] [golden_dir]    (default golden)
+
+      -g  Write the golden images instead of comparing
+
+   Returns 1 if any pixel differs or a golden image is missing.
+
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gdisp.h>
+#include <s6d0129x.h>
+#include "ghwtrans.h"
+#include "hx8357emu.h"
+#include "hostview.h"
+
+typedef struct
+   {
+   const char *name;
+   void (*draw)(void);
+   } TEST_SCENE;
+
+/* The 8 corner colors of the RGB cube, twice */
+static GCODE GPALETTE_RGB PFCODE test_palette[16] =
+   {
+   {0x00,0x00,0x00},{0xff,0x00,0x00},{0x00,0xff,0x00},{0xff,0xff,0x00},
+   {0x00,0x00,0xff},{0xff,0x00,0xff},{0x00,0xff,0xff},{0xff,0xff,0xff},
+   {0x00,0x00,0x00},{0xff,0x00,0x00},{0x00,0xff,0x00},{0xff,0xff,0x00},
+   {0x00,0x00,0xff},{0xff,0x00,0xff},{0x00,0xff,0xff},{0xff,0xff,0xff}
+   };
+
+#define TEST_COLOR(i)  ghw_palette_opr[(i) & 0xf]
+
+/* Symbol and block sizes used by the scenes */
+#define TEST_SYMW 24
+#define TEST_SYMH 20
+#define TEST_BLKW 64
+#define TEST_BLKH 48
+
+static SGUCHAR test_sym[TEST_SYMW*TEST_SYMH*2];
+static SGUCHAR test_blk[GHW_BLK_SIZE(0,0,TEST_BLKW-1,TEST_BLKH-1)];
+
+/* Calls in the band scene, each symbol of the frame has its own data */
+#define TEST_BANDN 200
+static SGUCHAR test_bsym[TEST_BANDN][TEST_SYMW*TEST_SYMH*2];
+
+static unsigned long test_fail;   /* Errors found by the scenes */
+#ifdef GBUFFER
+static uint32_t test_stepped;     /* Pixels written by ghw_updatehw_step() */
+#endif
+
+/* Deterministic pseudo random sequence (same on all hosts) */
+static SGULONG test_seed;
+static SGUINT test_rand(SGUINT n)
+   {
+   test_seed = test_seed * 1103515245UL + 12345UL;
+   return (SGUINT)(((test_seed >> 16) & 0x7fff) % n);
+   }
+
+/*
+   Write any pending buffer content to the display. With TEST_STEP only
+   one time slice of TEST_STEP pixels is written, and the drawing goes
+   on with the flush in progress
+*/
+static void test_update(void)
+   {
+   #ifdef TEST_STEP
+   uint32_t n;
+   GHW_TR->flush();
+   n = hx8357emu_stat.pixels;
+   ghw_updatehw_step(TEST_STEP);
+   GHW_TR->flush();
+   if ((n = hx8357emu_stat.pixels - n) > TEST_STEP)
+      {
+      printf("ghw_updatehw_step(%u) wrote %lu pixels\n", (unsigned) TEST_STEP, (unsigned long) n);
+      test_fail++;
+      }
+   test_stepped += n;
+   #else
+   ghw_updatehw();
+   #endif
+   }
+
+/*
+   Symbol of w x h pixels in the given mode (1 bit b&w, 4 bit palette
+   or 16 bit RGB) with random content. Returns the bytes pr symbol row
+*/
+static SGUINT test_mksym(SGUCHAR *sym, GXT w, GYT h, SGUCHAR mode)
+   {
+   SGUINT bw,i;
+   GCOLOR c;
+   bw = (mode == 16) ? w*2 : (w*mode+7)/8;
+   for (i = 0; i < bw*h; i++)
+      {
+      if (mode == 16)
+         {
+         c = TEST_COLOR(test_rand(16));
+         sym[i++] = (SGUCHAR)(c >> 8);
+         sym[i] = (SGUCHAR) c;
+         }
+      else
+         sym[i] = (SGUCHAR) test_rand(256);
+      }
+   return bw;
+   }
+
+static void test_wrsym(GXT x, GYT y, GXT w, GYT h, SGUCHAR mode)
+   {
+   SGUINT bw = test_mksym(test_sym, w, h, mode & GHW_PALETTEMASK);
+   ghw_wrsym_ram(x, y, x+w-1, y+h-1, test_sym, bw, mode);
+   }
+
+/*
+   Clear the screen to palette color 0
+*/
+static void test_clear(void)
+   {
+   ghw_setcolor(TEST_COLOR(7), TEST_COLOR(0));
+   ghw_fill(0, 0, GDISPW-1, GDISPH-1, 0x0000);
+   test_update();
+   }
+
+/********************* Scenes *********************/
+
+/*
+   Each primitive at a fixed position
+*/
+static void test_prim(void)
+   {
+   GXT x;
+   GYT y;
+   SGUCHAR i;
+
+   test_seed = 1;
+
+   /* Color bars */
+   for (i = 0; i < 8; i++)
+      {
+      ghw_setcolor(TEST_COLOR(7-i), TEST_COLOR(i));
+      ghw_fill((GXT)(i*(GDISPW/8)), 0, (GXT)((i+1)*(GDISPW/8)-1), 39, 0x0000);
+      }
+
+   /* Fill patterns */
+   ghw_setcolor(TEST_COLOR(1), TEST_COLOR(4));
+   ghw_fill(0, 40, GDISPW/2-1, 79, 0x55aa);
+   ghw_setcolor(TEST_COLOR(3), TEST_COLOR(6));
+   ghw_fill(GDISPW/2, 40, GDISPW-1, 79, 0x0ff0);
+
+   /* Nested rectangles */
+   for (i = 0; i < 12; i++)
+      ghw_rectangle((GXT)(i*3), (GYT)(80+i*3), (GXT)(GDISPW-1-i*3), (GYT)(159-i*3), TEST_COLOR(i+1));
+
+   /* Pixel grid */
+   for (y = 160; y < 200; y += 3)
+      for (x = 0; x < GDISPW; x += 5)
+         ghw_setpixel(x, y, TEST_COLOR(x+y));
+
+   /* Symbols: b&w, inverse b&w, transparent b&w, 4 bit palette, 16 bit RGB */
+   ghw_setcolor(TEST_COLOR(2), TEST_COLOR(5));
+   test_wrsym(  3, 205, TEST_SYMW, TEST_SYMH, 1);
+   test_wrsym( 33, 205, TEST_SYMW, TEST_SYMH, 1 | GHW_INVERSE);
+   test_wrsym( 63, 205, TEST_SYMW, TEST_SYMH, 1 | GHW_TRANSPERANT);
+   test_wrsym( 93, 205, TEST_SYMW, TEST_SYMH, 4);
+   test_wrsym(123, 205, TEST_SYMW, TEST_SYMH, 16);
+   /* Odd width and clipped at the right edge */
+   test_wrsym(153, 205, 13, 7, 1);
+   test_wrsym(GDISPW-10, 230, TEST_SYMW, TEST_SYMH, 4);
+
+   /* Invert across the fill patterns and the bars */
+   ghw_setcolor(TEST_COLOR(1), TEST_COLOR(4));
+   ghw_invert(GDISPW/4, 20, 3*GDISPW/4, 79);
+
+   /* Scroll part of the rectangles */
+   ghw_setcolor(TEST_COLOR(7), TEST_COLOR(6));
+   ghw_gscroll(10, 90, GDISPW-11, 150, 7, 0x0000);
+   ghw_gscroll(0, 160, GDISPW-1, 199, 5, 0x0000);
+
+   /* Block copy of the top left corner to the bottom right corner */
+   ghw_rdblk(0, 0, TEST_BLKW-1, TEST_BLKH-1, test_blk, sizeof(test_blk));
+   ghw_wrblk(GDISPW-TEST_BLKW, GDISPH-TEST_BLKH, GDISPW-1, GDISPH-1, test_blk);
+   }
+
+/*
+   Random sequence of cnt primitives with intermediate updates
+*/
+static void test_random(SGUINT cnt)
+   {
+   SGUINT n;
+   GXT x0,x1;
+   GYT y0,y1;
+
+   for (n = 0; n < cnt; n++)
+      {
+      x0 = (GXT) test_rand(GDISPW);
+      y0 = (GYT) test_rand(GDISPH);
+      x1 = (GXT)(x0 + test_rand(64));
+      y1 = (GYT)(y0 + test_rand(64));
+      if (x1 >= GDISPW)
+         x1 = GDISPW-1;
+      if (y1 >= GDISPH)
+         y1 = GDISPH-1;
+      switch (test_rand(10))
+         {
+         case 0:
+            ghw_setpixel(x0, y0, TEST_COLOR(test_rand(16)));
+            break;
+         case 1:
+            ghw_fill(x0, y0, x1, y1, (test_rand(3) == 0) ? 0x55aa : ((test_rand(2) != 0) ? 0xffff : 0x0000));
+            break;
+         case 2:
+            ghw_invert(x0, y0, x1, y1);
+            break;
+         case 3:
+            ghw_rectangle(x0, y0, x1, y1, TEST_COLOR(test_rand(16)));
+            break;
+         case 4:
+            ghw_gscroll(x0, y0, x1, y1, (GYT) test_rand(20), (test_rand(2) != 0) ? 0xffff : 0x0000);
+            break;
+         case 5:
+            {
+            static const SGUCHAR modes[] =
+               {1, 1 | GHW_INVERSE, 1 | GHW_TRANSPERANT, 4, 16};
+            test_wrsym(x0, y0, (GXT)(1 + test_rand(TEST_SYMW)), (GYT)(1 + test_rand(TEST_SYMH)),
+               modes[test_rand(sizeof(modes))]);
+            break;
+            }
+         case 6:
+            if (x1 - x0 < TEST_BLKW && y1 - y0 < TEST_BLKH)
+               {
+               ghw_rdblk(x0, y0, x1, y1, test_blk, sizeof(test_blk));
+               x0 = (GXT) test_rand(GDISPW);
+               y0 = (GYT) test_rand(GDISPH);
+               ghw_wrblk(x0, y0, (GXT)(x0 + test_rand(TEST_BLKW)), (GYT)(y0 + test_rand(TEST_BLKH)), test_blk);
+               }
+            break;
+         default:
+            ghw_setcolor(TEST_COLOR(test_rand(16)), TEST_COLOR(test_rand(16)));
+            break;
+         }
+      if (test_rand(16) == 0)
+         test_update();
+      }
+   }
+
+/*
+   Random sequence of all primitives with intermediate updates
+*/
+static void test_mix(void)
+   {
+   test_seed = 2;
+   test_random(3000);
+   }
+
+/*
+   Random sequence drawn with delayed update. The drawing calls and
+   ghw_updatehw() must not write to the display, only the
+   ghw_updatehw_step() calls of test_update() with TEST_STEP.
+   ghw_setupdate(1) must then complete the flush
+*/
+static void test_delay(void)
+   {
+   #ifdef GBUFFER
+   uint32_t n;
+   ghw_setupdate(0);
+   GHW_TR->flush();
+   n = hx8357emu_stat.pixels;
+   test_stepped = 0;
+   #endif
+
+   test_seed = 5;
+   test_random(1500);
+
+   #ifdef GBUFFER
+   GHW_TR->flush();
+   if ((n = hx8357emu_stat.pixels - n - test_stepped) != 0)
+      {
+      printf("delay: %lu pixels written by the drawing with ghw_setupdate(0)\n", (unsigned long) n);
+      test_fail++;
+      }
+   #ifdef TEST_STEP
+   if (test_stepped == 0)
+      {
+      printf("delay: ghw_updatehw_step() wrote nothing with ghw_setupdate(0)\n");
+      test_fail++;
+      }
+   #endif
+   ghw_setupdate(1);
+   if (ghw_updatehw_step(0) != 0)
+      {
+      printf("delay: ghw_setupdate(1) did not complete the flush\n");
+      test_fail++;
+      }
+   #endif
+   }
+
+/*
+   Terminal style scrolling of full width areas, with drawing across the
+   area borders between the scroll steps (GHW_HW_SCROLL translation)
+*/
+#define TEST_LOGT (GDISPH/4)         /* Log area */
+#define TEST_LOGB (GDISPH*3/4-1)
+#define TEST_LOGL 12                 /* Log line height */
+
+static void test_scroll(void)
+   {
+   SGUINT n;
+   GXT x,x1;
+   GYT y,y1;
+
+   test_seed = 3;
+   for (y = 0; y < GDISPH; y += 16)
+      {
+      ghw_setcolor(TEST_COLOR(y/16+1), TEST_COLOR(y/16));
+      ghw_fill(0, y, GDISPW-1, (GYT)(y+15), 0x55aa);
+      }
+
+   for (n = 0; n < 60; n++)
+      {
+      /* New log line */
+      ghw_setcolor(TEST_COLOR(test_rand(8)), TEST_COLOR(test_rand(8)));
+      ghw_gscroll(0, TEST_LOGT, GDISPW-1, TEST_LOGB, TEST_LOGL, 0x0000);
+      for (x = 0; x + TEST_SYMW <= GDISPW; x += TEST_SYMW)
+         test_wrsym(x, TEST_LOGB-TEST_LOGL+1, TEST_SYMW, TEST_LOGL, 1);
+
+      /* Primitives across the area borders */
+      x = (GXT) test_rand(GDISPW/2);
+      x1 = (GXT)(x + test_rand(GDISPW/2));
+      y = (GYT)(TEST_LOGT - 20 + test_rand(40));
+      y1 = (GYT)(TEST_LOGB - 20 + test_rand(40));
+      ghw_rectangle(x, y, x1, y1, TEST_COLOR(test_rand(16)));
+      ghw_invert(x, (GYT)(y + test_rand(TEST_LOGB-TEST_LOGT)), x1, y1);
+      ghw_setpixel((GXT) test_rand(GDISPW), (GYT) test_rand(GDISPH), TEST_COLOR(test_rand(16)));
+
+      if ((n % 10) == 9)
+         {
+         /* Second full width area below the log area */
+         ghw_gscroll(0, TEST_LOGB+9, GDISPW-1, GDISPH-1, 5, 0xffff);
+         /* Block copy out of and into the log area */
+         ghw_rdblk(x, (GYT)(TEST_LOGT-TEST_BLKH/2), (GXT)(x+TEST_BLKW-1), (GYT)(TEST_LOGT+TEST_BLKH/2-1), test_blk, sizeof(test_blk));
+         ghw_wrblk(x1/2, (GYT)(TEST_LOGB-TEST_BLKH/2), (GXT)(x1/2+TEST_BLKW-1), (GYT)(TEST_LOGB+TEST_BLKH/2-1), test_blk);
+         }
+      if (test_rand(4) == 0)
+         test_update();
+      }
+   }
+
+/*
+   One frame of the calls which GHW_BAND_ROWS records (fill, rectangle,
+   pixel, symbol, block), crossing the band borders. With GHW_BAND_ROWS
+   the frame is recorded and replayed band by band, else drawn directly
+*/
+static void test_band(void)
+   {
+   SGUINT n,bw;
+   GXT x0,x1;
+   GYT y0,y1;
+   SGUCHAR mode;
+   static const SGUCHAR modes[] =
+      {1, 1 | GHW_INVERSE, 1 | GHW_TRANSPERANT, 4, 16};
+
+   test_seed = 4;
+   /* Block source, read before the frame */
+   ghw_setcolor(TEST_COLOR(3), TEST_COLOR(4));
+   ghw_fill(0, 0, TEST_BLKW-1, TEST_BLKH-1, 0x0ff0);
+   test_wrsym(5, 5, TEST_SYMW, TEST_SYMH, 16);
+   ghw_rdblk(0, 0, TEST_BLKW-1, TEST_BLKH-1, test_blk, sizeof(test_blk));
+
+   #ifdef GHW_BAND_ROWS
+   ghw_band_begin();
+   #endif
+   ghw_setcolor(TEST_COLOR(5), TEST_COLOR(2));
+   ghw_fill(0, 0, GDISPW-1, GDISPH-1, 0x55aa);
+   for (n = 0; n < TEST_BANDN; n++)
+      {
+      x0 = (GXT) test_rand(GDISPW);
+      y0 = (GYT) test_rand(GDISPH);
+      /* Include single row and single column areas */
+      x1 = (GXT)(x0 + ((test_rand(8) == 0) ? 0 : test_rand(80)));
+      y1 = (GYT)(y0 + ((test_rand(8) == 0) ? 0 : test_rand(80)));
+      if (x1 >= GDISPW)
+         x1 = GDISPW-1;
+      if (y1 >= GDISPH)
+         y1 = GDISPH-1;
+      switch (test_rand(6))
+         {
+         case 0:
+            ghw_setpixel(x0, y0, TEST_COLOR(test_rand(16)));
+            break;
+         case 1:
+            ghw_fill(x0, y0, x1, y1, (test_rand(2) == 0) ? 0x55aa : 0xffff);
+            break;
+         case 2:
+            ghw_rectangle(x0, y0, x1, y1, TEST_COLOR(test_rand(16)));
+            break;
+         case 3:
+            mode = modes[test_rand(sizeof(modes))];
+            x1 = (GXT)(1 + test_rand(TEST_SYMW));
+            y1 = (GYT)(1 + test_rand(TEST_SYMH));
+            bw = test_mksym(test_bsym[n], x1, y1, mode & GHW_PALETTEMASK);
+            ghw_wrsym_ram(x0, y0, (GXT)(x0+x1-1), (GYT)(y0+y1-1), test_bsym[n], bw, mode);
+            break;
+         case 4:
+            /* May be larger than the block */
+            ghw_wrblk(x0, y0, (GXT)(x0 + test_rand(TEST_BLKW+8)), (GYT)(y0 + test_rand(TEST_BLKH+8)), test_blk);
+            break;
+         default:
+            ghw_setcolor(TEST_COLOR(test_rand(16)), TEST_COLOR(test_rand(16)));
+            break;
+         }
+      }
+   #ifdef GHW_BAND_ROWS
+   if (ghw_band_end() != 0)
+      {
+      printf("band: the recording was ended early (GHW_BAND_LIST too small)\n");
+      test_fail++;
+      }
+   #endif
+   }
+
+static const TEST_SCENE test_scenes[] =
+   {
+   {"prim",   test_prim},
+   {"mix",    test_mix},
+   {"scroll", test_scroll},
+   {"band",   test_band},
+   {"delay",  test_delay}
+   };
+
+/********************* Compare *********************/
+
+/*
+   Compare the display with dir/name.ppm (or write it with golden != 0).
+   Returns the number of differences
+*/
+static unsigned long test_check(const char *name, const char *dir, int golden)
+   {
+   char fname[256];
+   FILE *fp;
+   unsigned w,h,x,y;
+   unsigned long diff = 0;
+   uint32_t rgb;
+   GCOLOR c,d;
+   uint8_t *img,*p;
+
+   /* Frame buffer / display read back must match the display */
+   for (y = 0; y < GDISPH; y++)
+      for (x = 0; x < GDISPW; x++)
+         {
+         rgb = hx8357emu_pixel((uint16_t) x, (uint16_t) y, HOST_VIEW);
+         d = G_RGB_TO_COLOR((SGUCHAR)(rgb >> 16), (SGUCHAR)(rgb >> 8), (SGUCHAR) rgb);
+         c = ghw_getpixel((GXT) x, (GYT) y);
+         if ((c & GHW_COLOR_CMP_MSK) != (d & GHW_COLOR_CMP_MSK))
+            {
+            if (diff++ < 5)
+               printf("%s: ghw_getpixel(%u,%u) = 0x%06lx, display 0x%06lx\n", name, x, y,
+                  (unsigned long) c, (unsigned long) d);
+            }
+         }
+
+   snprintf(fname, sizeof(fname), "%s/%s.ppm", dir, name);
+   if (golden)
+      {
+      if (hx8357emu_save(fname, HOST_VIEW) != 0)
+         {
+         fprintf(stderr, "Cannot write %s\n", fname);
+         return diff + 1;
+         }
+      printf("%s: written to %s\n", name, fname);
+      return diff;
+      }
+
+   if ((fp = fopen(fname, "rb")) == NULL)
+      {
+      printf("%s: no golden image %s (make golden)\n", name, fname);
+      return diff + 1;
+      }
+   if ((fscanf(fp, "P6 %u %u 255", &w, &h) != 2) || (fgetc(fp) == EOF) ||
+       (w != hx8357emu_width(HOST_VIEW)) || (h != hx8357emu_height(HOST_VIEW)))
+      {
+      printf("%s: %s is not a %ux%u PPM image\n", name, fname,
+         (unsigned) hx8357emu_width(HOST_VIEW), (unsigned) hx8357emu_height(HOST_VIEW));
+      fclose(fp);
+      return diff + 1;
+      }
+   if ((img = (uint8_t *) malloc((size_t) w*h*3)) == NULL)
+      {
+      fclose(fp);
+      return diff + 1;
+      }
+   if (fread(img, 3, (size_t) w*h, fp) != (size_t) w*h)
+      {
+      printf("%s: %s is truncated\n", name, fname);
+      diff++;
+      }
+   else
+      {
+      for (y = 0, p = img; y < h; y++)
+         for (x = 0; x < w; x++, p += 3)
+            {
+            rgb = hx8357emu_pixel((uint16_t) x, (uint16_t) y, HOST_VIEW);
+            if ((p[0] != (uint8_t)(rgb >> 16)) || (p[1] != (uint8_t)(rgb >> 8)) || (p[2] != (uint8_t) rgb))
+               {
+               if (diff++ < 5)
+                  printf("%s: pixel (%u,%u) = 0x%06lx, golden 0x%02x%02x%02x\n", name, x, y,
+                     (unsigned long) rgb, p[0], p[1], p[2]);
+               }
+            }
+      }
+   free(img);
+   fclose(fp);
+   printf("%s: %s (%lu differences)\n", name, (diff == 0) ? "ok" : "FAILED", diff);
+   return diff;
+   }
+
+int main(int argc, char *argv[])
+   {
+   const char *dir = "golden";
+   int golden = 0;
+   int i;
+   unsigned long diff = 0;
+
+   for (i = 1; i < argc; i++)
+      {
+      if (strcmp(argv[i], "-g") == 0)
+         golden = 1;
+      else if (argv[i][0] != '-')
+         dir = argv[i];
+      else
+         {
+         fprintf(stderr, "Usage: %s [-g] [golden_dir]\n", argv[0]);
+         return 1;
+         }
+      }
+
+   hx8357emu_reset();
+   hx8357emu_attach();
+   if (ghw_init() != 0)
+      {
+      fprintf(stderr, "ghw_init failed\n");
+      return 1;
+      }
+   /* The stepped display clear writes each pixel once */
+   GHW_TR->flush();
+   if (hx8357emu_stat.pixels != (uint32_t) GDISPW * GDISPH)
+      {
+      printf("init: %lu pixels cleared, expected %lu\n", (unsigned long) hx8357emu_stat.pixels,
+         (unsigned long) GDISPW * GDISPH);
+      test_fail++;
+      }
+   ghw_palette_wr(0, 16, test_palette);
+
+   for (i = 0; i < (int)(sizeof(test_scenes)/sizeof(test_scenes[0])); i++)
+      {
+      test_clear();
+      test_scenes[i].draw();
+      ghw_updatehw();   /* Complete the flush */
+      GHW_TR->flush();
+      diff += test_check(test_scenes[i].name, dir, golden);
+      }
+   ghw_exit();
+   return ((diff + test_fail) != 0) ? 1 : 0;
+   }
@@ -0,0 +1,461 @@
+/***************************** ghwtrcan.c ************************************
+
+   Display bus trace analyzer (host build, see Makefile)
+
+   A trace recorded with ghwtrace.h (a file from the host build, or the
+   RAM ring read out from the target) is replayed on the HX8357D emulator,
+   and the bus bandwidth is broken down to show where it is wasted:
+
+      Bytes pr command   Share of the bus bytes (command byte, parameters,
+                         pixel data and read data) pr command type.
+      Windows            CASET / RASET commands which set the value already
+                         in the controller, and CASET / RASET values which
+                         are replaced before any RAMWR / RAMRD used them.
+      Overdraw           Pixels written more than once within a frame
+                         (frames are delimited by ghw_trace_frame()).
+      Unchanged writes   Pixel writes which left the GRAM content unchanged.
+
+   Optionally an overdraw heat map is saved in the display orientation:
+      black   not written
+      blue    written once pr frame
+      red -> yellow -> white  increasing number of extra writes
+
+   Usage:
+      ghwtrcan [-v view] [-m heatmap.png] trace_file
+
+      -v  View (MADCTL bits, see hx8357emu.h), default the gdispcfg.h
+          orientation
+      -m  Save the overdraw heat map (PNG or PPM)
+
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gdisp.h>
+#include "ghwtrace.h"
+#include "hx8357emu.h"
+#include "hostview.h"
+
+#define TRC_COLS  HX8357EMU_COLS
+#define TRC_ROWS  HX8357EMU_ROWS
+#define TRC_TILE  16             /* Tile size for the overdraw ranking */
+#define TRC_TOP   5              /* Tiles listed */
+
+/* Commands with special handling */
+#define TRC_SWRESET  0x01
+#define TRC_CASET    0x2A
+#define TRC_RASET    0x2B
+#define TRC_RAMWR    0x2C
+#define TRC_RAMRD    0x2E
+#define TRC_COLMOD   0x3A
+#define TRC_RAMWRC   0x3C
+#define TRC_RAMRDC   0x3E
+
+static const struct
+   {
+   uint8_t cmd;
+   const char *name;
+   } trc_names[] =
+   {
+   {0x01,"SWRESET"}, {0x11,"SLPOUT"},  {0x13,"NORON"},   {0x20,"INVOFF"},
+   {0x21,"INVON"},   {0x28,"DISPOFF"}, {0x29,"DISPON"},  {0x2A,"CASET"},
+   {0x2B,"RASET"},   {0x2C,"RAMWR"},   {0x2E,"RAMRD"},   {0x33,"VSCRDEF"},
+   {0x35,"TEON"},    {0x36,"MADCTL"},  {0x37,"VSCRSADD"},{0x3A,"COLMOD"},
+   {0x3C,"RAMWRC"},  {0x3E,"RAMRDC"},  {0x44,"TESCAN"},  {0xB0,"SETOSC"},
+   {0xB1,"SETPWR1"}, {0xB3,"SETRGB"},  {0xB4,"SETCYC"},  {0xB6,"SETCOM"},
+   {0xB9,"SETEXTC"}, {0xC0,"SETSTBA"}, {0xCC,"SETPANEL"},{0xE0,"SETGAMMA"}
+   };
+
+/* Bytes pr command type */
+static unsigned long trc_cmdcnt[256];
+static unsigned long trc_cmdbytes[256];
+static unsigned long trc_total;
+static int trc_cmd = -1;        /* Current command, -1 before the first */
+
+/* Window tracking, index 0 = CASET, 1 = RASET */
+static uint8_t  trc_args[4];
+static uint16_t trc_argn;
+static uint8_t  trc_win[2][4];  /* Value held by the controller */
+static uint8_t  trc_winok[2];   /* trc_win is known */
+static uint8_t  trc_winpend[2]; /* Value set, but not used by RAMWR / RAMRD yet */
+static unsigned long trc_winsame, trc_winsame_bytes;
+static unsigned long trc_winunused, trc_winunused_bytes;
+static uint8_t trc_pixbytes = 3; /* Bytes pr pixel (COLMOD) */
+
+/* Pixel writes */
+static uint16_t trc_cnt[TRC_ROWS][TRC_COLS];   /* Writes in current frame */
+static uint32_t trc_heat[TRC_ROWS][TRC_COLS];  /* Extra writes, all frames */
+static uint8_t  trc_written[TRC_ROWS][TRC_COLS];
+static uint32_t trc_heatmax;
+static uint8_t  trc_framedirty;  /* Pixels written since the last frame end */
+static unsigned long trc_frames, trc_flushes;
+static unsigned long trc_pixels, trc_unchanged;
+static unsigned long trc_overpix, trc_overwr;
+
+static const char *trc_name(uint8_t cmd)
+   {
+   static char buf[8];
+   unsigned i;
+   for (i = 0; i < sizeof(trc_names)/sizeof(trc_names[0]); i++)
+      if (trc_names[i].cmd == cmd)
+         return trc_names[i].name;
+   sprintf(buf, "0x%02X", (unsigned) cmd);
+   return buf;
+   }
+
+static void trc_wrhook(uint16_t col, uint16_t row, uint32_t old, uint32_t rgb)
+   {
+   trc_pixels++;
+   if (old == rgb)
+      trc_unchanged++;
+   if (trc_cnt[row][col] < 0xffff)
+      trc_cnt[row][col]++;
+   trc_written[row][col] = 1;
+   trc_framedirty = 1;
+   }
+
+/*
+   End of frame, add the pixels written more than once to the overdraw
+*/
+static void trc_frame_end(void)
+   {
+   uint16_t c,r;
+   for (r = 0; r < TRC_ROWS; r++)
+      for (c = 0; c < TRC_COLS; c++)
+         {
+         if (trc_cnt[r][c] > 1)
+            {
+            trc_overpix++;
+            trc_overwr += trc_cnt[r][c] - 1;
+            trc_heat[r][c] += trc_cnt[r][c] - 1;
+            if (trc_heat[r][c] > trc_heatmax)
+               trc_heatmax = trc_heat[r][c];
+            }
+         trc_cnt[r][c] = 0;
+         }
+   trc_frames++;
+   trc_framedirty = 0;
+   }
+
+/* Count a bus byte to the current command */
+static void trc_count(void)
+   {
+   trc_total++;
+   if (trc_cmd >= 0)
+      trc_cmdbytes[trc_cmd]++;
+   }
+
+static void trc_command(uint8_t cmd)
+   {
+   trc_cmd = cmd;
+   trc_cmdcnt[cmd]++;
+   trc_count();
+   trc_argn = 0;
+   switch (cmd)
+      {
+      case TRC_SWRESET:
+         trc_winok[0] = trc_winok[1] = 0;
+         trc_winpend[0] = trc_winpend[1] = 0;
+         break;
+      case TRC_RAMWR:
+      case TRC_RAMWRC:
+      case TRC_RAMRD:
+      case TRC_RAMRDC:
+         trc_winpend[0] = trc_winpend[1] = 0;
+         break;
+      default:
+         break;
+      }
+   hx8357emu_byte(0, cmd);
+   }
+
+/* Completed CASET or RASET (axis 0 or 1) */
+static void trc_window(uint8_t axis)
+   {
+   if (trc_winok[axis] && (memcmp(trc_win[axis], trc_args, 4) == 0))
+      {
+      trc_winsame++;
+      trc_winsame_bytes += 5;
+      return;   /* The value is still in use if it was pending */
+      }
+   if (trc_winpend[axis])
+      {
+      trc_winunused++;
+      trc_winunused_bytes += 5;
+      }
+   memcpy(trc_win[axis], trc_args, 4);
+   trc_winok[axis] = 1;
+   trc_winpend[axis] = 1;
+   }
+
+static void trc_data(uint8_t dat)
+   {
+   trc_count();
+   if (trc_argn < sizeof(trc_args))
+      trc_args[trc_argn] = dat;
+   trc_argn++;
+   if (trc_argn == 4)
+      {
+      if (trc_cmd == TRC_CASET)
+         trc_window(0);
+      else if (trc_cmd == TRC_RASET)
+         trc_window(1);
+      }
+   else if ((trc_argn == 1) && (trc_cmd == TRC_COLMOD))
+      trc_pixbytes = ((dat & 0x07) == 0x05) ? 2 : 3;
+   hx8357emu_byte(1, dat);
+   }
+
+/*
+   Replay the trace records in buf. Returns 0 if the trace is well formed
+*/
+static int trc_replay(const uint8_t *buf, long len)
+   {
+   long i = 0;
+   uint32_t count;
+   uint8_t n;
+   while (i < len)
+      {
+      switch (buf[i])
+         {
+         case GHW_TRC_CMD:
+            if (i + 2 > len)
+               return -1;
+            trc_command(buf[i+1]);
+            i += 2;
+            break;
+         case GHW_TRC_DATA:
+            if (i + 2 > len)
+               return -1;
+            trc_data(buf[i+1]);
+            i += 2;
+            break;
+         case GHW_TRC_BURST:
+            if ((i + 2 > len) || (i + 2 + buf[i+1] > len))
+               return -1;
+            for (n = 0; n < buf[i+1]; n++)
+               trc_data(buf[i+2+n]);
+            i += 2 + buf[i+1];
+            break;
+         case GHW_TRC_REPEAT:
+            if (i + 7 > len)
+               return -1;
+            count = ((uint32_t) buf[i+3]) | (((uint32_t) buf[i+4]) << 8) |
+                    (((uint32_t) buf[i+5]) << 16) | (((uint32_t) buf[i+6]) << 24);
+            while (count--)
+               {
+               trc_data(buf[i+1]);
+               trc_data(buf[i+2]);
+               }
+            i += 7;
+            break;
+         case GHW_TRC_READ:
+            if (i + 2 > len)
+               return -1;
+            trc_count();
+            (void) hx8357emu_read();   /* Keep the emulator address counter in step */
+            i += 2;
+            break;
+         case GHW_TRC_FLUSH:
+            trc_flushes++;
+            i++;
+            break;
+         case GHW_TRC_FRAME:
+            trc_frame_end();
+            i++;
+            break;
+         default:
+            fprintf(stderr, "Unknown record 0x%02X at offset %ld\n", (unsigned) buf[i], i);
+            return -1;
+         }
+      }
+   return 0;
+   }
+
+static double trc_pct(unsigned long n, unsigned long total)
+   {
+   return (total != 0) ? (100.0 * n) / total : 0.0;
+   }
+
+static void trc_report(void)
+   {
+   uint8_t order[256];
+   unsigned i,j;
+   unsigned n = 0;
+
+   printf("Trace: %lu bytes on the bus, %lu frames, %lu flushes\n\n",
+      trc_total, trc_frames, trc_flushes);
+
+   /* Commands sorted by bytes */
+   for (i = 0; i < 256; i++)
+      if (trc_cmdcnt[i] != 0)
+         order[n++] = (uint8_t) i;
+   for (i = 1; i < n; i++)
+      for (j = i; (j > 0) && (trc_cmdbytes[order[j]] > trc_cmdbytes[order[j-1]]); j--)
+         {
+         uint8_t t = order[j];
+         order[j] = order[j-1];
+         order[j-1] = t;
+         }
+   printf("%-9s %8s %10s %7s\n", "command", "count", "bytes", "share");
+   for (i = 0; i < n; i++)
+      printf("%-9s %8lu %10lu %6.1f%%\n", trc_name(order[i]),
+         trc_cmdcnt[order[i]], trc_cmdbytes[order[i]],
+         trc_pct(trc_cmdbytes[order[i]], trc_total));
+
+   printf("\nWindows: %lu CASET/RASET\n", trc_cmdcnt[TRC_CASET] + trc_cmdcnt[TRC_RASET]);
+   printf("  same value as set      %8lu  (%lu bytes, %.1f%%)\n",
+      trc_winsame, trc_winsame_bytes, trc_pct(trc_winsame_bytes, trc_total));
+   printf("  replaced before use    %8lu  (%lu bytes, %.1f%%)\n",
+      trc_winunused, trc_winunused_bytes, trc_pct(trc_winunused_bytes, trc_total));
+
+   printf("\nPixels: %lu written\n", trc_pixels);
+   printf("  overdraw, extra writes %8lu  (%lu bytes, %.1f%%) on %lu pixels\n",
+      trc_overwr, trc_overwr * trc_pixbytes, trc_pct(trc_overwr * trc_pixbytes, trc_total),
+      trc_overpix);
+   printf("  unchanged GRAM         %8lu  (%lu bytes, %.1f%%)\n",
+      trc_unchanged, trc_unchanged * trc_pixbytes,
+      trc_pct(trc_unchanged * trc_pixbytes, trc_total));
+   }
+
+/********************* Overdraw map *********************/
+
+static uint8_t trc_view;
+
+/* Extra writes at view position x,y */
+static uint32_t trc_heat_at(uint16_t x, uint16_t y, uint8_t *written)
+   {
+   uint16_t col, row;
+   if (!hx8357emu_gram_pos(x, y, trc_view, &col, &row))
+      {
+      *written = 0;
+      return 0;
+      }
+   *written = trc_written[row][col];
+   return trc_heat[row][col];
+   }
+
+static uint32_t trc_heat_pixel(uint16_t x, uint16_t y)
+   {
+   uint8_t written;
+   uint32_t h = trc_heat_at(x, y, &written);
+   uint32_t t;
+   if (!written)
+      return 0x000000;
+   if (h == 0)
+      return 0x000080;
+   /* Red -> yellow -> white */
+   t = (uint32_t)((h * 510UL) / trc_heatmax);
+   if (t <= 255)
+      return 0xff0000 | (t << 8);
+   return 0xffff00 | (t - 255);
+   }
+
+/* Tiles (in the view) with most extra writes */
+static void trc_tiles(void)
+   {
+   uint16_t w = hx8357emu_width(trc_view);
+   uint16_t h = hx8357emu_height(trc_view);
+   uint16_t tw = (uint16_t)((w + TRC_TILE - 1) / TRC_TILE);
+   uint16_t th = (uint16_t)((h + TRC_TILE - 1) / TRC_TILE);
+   unsigned long *tile;
+   unsigned long best;
+   uint16_t x,y;
+   uint8_t written;
+   unsigned i,k,bi = 0;
+
+   if ((trc_overwr == 0) ||
+       ((tile = (unsigned long *) calloc((size_t) tw * th, sizeof(unsigned long))) == NULL))
+      return;
+   for (y = 0; y < h; y++)
+      for (x = 0; x < w; x++)
+         tile[(y / TRC_TILE) * tw + x / TRC_TILE] += trc_heat_at(x, y, &written);
+
+   printf("\nOverdraw hot spots (%ux%u tiles, view coordinates):\n", TRC_TILE, TRC_TILE);
+   for (k = 0; k < TRC_TOP; k++)
+      {
+      best = 0;
+      for (i = 0; i < (unsigned) tw * th; i++)
+         if (tile[i] > best)
+            {
+            best = tile[i];
+            bi = i;
+            }
+      if (best == 0)
+         break;
+      printf("  x %3u-%3u  y %3u-%3u  %8lu extra writes\n",
+         (bi % tw) * TRC_TILE, (bi % tw) * TRC_TILE + TRC_TILE - 1,
+         (bi / tw) * TRC_TILE, (bi / tw) * TRC_TILE + TRC_TILE - 1, best);
+      tile[bi] = 0;
+      }
+   free(tile);
+   }
+
+int main(int argc, char *argv[])
+   {
+   const char *fname = NULL;
+   const char *mapname = NULL;
+   uint8_t *buf;
+   long len;
+   FILE *fp;
+   int i;
+   int usage = 0;
+
+   trc_view = HOST_VIEW;
+   for (i = 1; i < argc; i++)
+      {
+      if ((strcmp(argv[i], "-v") == 0) && (i+1 < argc))
+         trc_view = (uint8_t) strtoul(argv[++i], NULL, 0);
+      else if ((strcmp(argv[i], "-m") == 0) && (i+1 < argc))
+         mapname = argv[++i];
+      else if ((argv[i][0] != '-') && (fname == NULL))
+         fname = argv[i];
+      else
+         usage = 1;
+      }
+   if (usage || (fname == NULL))
+      {
+      fprintf(stderr, "Usage: %s [-v view] [-m heatmap.png] trace_file\n", argv[0]);
+      return 2;
+      }
+
+   if ((fp = fopen(fname, "rb")) == NULL)
+      {
+      fprintf(stderr, "Cannot open %s\n", fname);
+      return 2;
+      }
+   fseek(fp, 0, SEEK_END);
+   len = ftell(fp);
+   fseek(fp, 0, SEEK_SET);
+   if ((len < 0) || ((buf = (uint8_t *) malloc(len + 1)) == NULL) ||
+       (fread(buf, 1, len, fp) != (size_t) len))
+      {
+      fprintf(stderr, "Cannot read %s\n", fname);
+      fclose(fp);
+      return 2;
+      }
+   fclose(fp);
+
+   hx8357emu_reset();
+   hx8357emu_wrhook = trc_wrhook;
+   if (trc_replay(buf, len) != 0)
+      fprintf(stderr, "%s: truncated or corrupt trace, analysing the valid part\n", fname);
+   free(buf);
+   if (trc_framedirty)
+      trc_frame_end();   /* Pixels after the last frame mark */
+
+   trc_report();
+   trc_tiles();
+
+   if (mapname != NULL)
+      {
+      if (hx8357emu_save_image(mapname, hx8357emu_width(trc_view),
+                               hx8357emu_height(trc_view), trc_heat_pixel) != 0)
+         {
+         fprintf(stderr, "Cannot write %s\n", mapname);
+         return 1;
+         }
+      printf("\nOverdraw map saved to %s\n", mapname);
+      }
+   return 0;
+   }
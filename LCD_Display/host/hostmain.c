@@ -0,0 +1,155 @@
+/***************************** hostmain.c ************************************
+
+   Host build of the display driver with the HX8357D emulator.
+
+   The driver runs unmodified on the mock transport (ghwtrans.c), which
+   feeds the command stream to the emulator (hx8357emu.c). The resulting
+   display image is saved so it can be inspected or compared pixel by
+   pixel with a reference image.
+
+   Usage:
+      ghwhost [image.png | image.ppm] [trace_file]   (default gram.png)
+
+   With GHW_TRACE the bus traffic is recorded to trace_file (ghwtrace.h)
+   for analysis with ghwtrcan. Initialization and drawing are recorded as
+   two frames.
+
+****************************************************************************/
+#include <stdio.h>
+#include <gdisp.h>
+#include "ghwtrans.h"
+#include "ghwstats.h"
+#include "ghwtrace.h"
+#include "hx8357emu.h"
+#include "hostview.h"
+
+#if (defined( GBUFFER ) && defined( GHW_XMEM_BUF ))
+extern SGULONG ghw_xmem_switches;   /* ghwxmem.c bank model */
+#endif
+
+/*
+   The drawing sequence used by main.c, followed by a color bar
+   test pattern
+*/
+static void host_draw(void)
+   {
+   static const GCOLOR bars[] =
+      {G_BLACK, G_RED, G_GREEN, G_YELLOW, G_BLUE, G_MAGENTA, G_CYAN, G_WHITE};
+   GXT x,w;
+   SGUCHAR i;
+
+   gputs("\nUsing SYSFONT");
+   gselfont(&ariel9);
+   gputs("Using ariel9");
+   gselfont(&SYSFONT);
+   gputs("\nUsing SYSFONT");
+
+   w = GDISPW/(sizeof(bars)/sizeof(bars[0]));
+   for (i = 0, x = 0; i < sizeof(bars)/sizeof(bars[0]); i++, x += w)
+      {
+      gsetcolorb(bars[i]);
+      gfillvp(x, GDISPH-40, x+w-1, GDISPH-1, 0x0000);
+      }
+   gsetcolorf(G_WHITE);
+   grectangle(0, GDISPH-41, GDISPW-1, GDISPH-1);
+   }
+
+#ifdef GHW_STATS
+/*
+   Bus cost pr driver entry point (ghwstats.h)
+*/
+static void host_stats(void)
+   {
+   static const char *names[GHW_STAT_ENTRIES] = GHW_STAT_NAMES;
+   GHW_STATCNT st;
+   SGUCHAR i;
+   printf("%-10s %6s %8s %9s %8s %8s %7s %8s %7s %6s\n",
+      "entry", "calls", "cmd", "data", "cs", "dc", "windows", "pix_wr", "pix_rd", "rdturn");
+   for (i = 0; i <= GHW_STAT_ENTRIES; i++)
+      {
+      ghw_stats_get((i < GHW_STAT_ENTRIES) ? i : GHW_STAT_ALL, &st);
+      if (st.calls == 0 && st.cmd_bytes == 0 && st.data_bytes == 0)
+         continue;
+      printf("%-10s %6lu %8lu %9lu %8lu %8lu %7lu %8lu %7lu %6lu\n",
+         (i < GHW_STAT_ENTRIES) ? names[i] : "all",
+         (unsigned long) st.calls, (unsigned long) st.cmd_bytes,
+         (unsigned long) st.data_bytes, (unsigned long) st.cs_assert,
+         (unsigned long) st.dc_toggle, (unsigned long) st.windows,
+         (unsigned long) st.pix_wr, (unsigned long) st.pix_rd,
+         (unsigned long) st.rd_turn);
+      }
+   }
+#endif
+
+#ifdef GHW_TRACE
+static FILE *host_trc;
+
+static void host_trace_sink(const uint8_t *rec, uint8_t len)
+   {
+   fwrite(rec, 1, len, host_trc);
+   }
+#endif
+
+int main(int argc, char *argv[])
+   {
+   const char *fname = (argc > 1) ? argv[1] : "gram.png";
+
+   hx8357emu_reset();
+   hx8357emu_attach();
+
+   #ifdef GHW_TRACE
+   if (argc > 2)
+      {
+      if ((host_trc = fopen(argv[2], "wb")) == NULL)
+         {
+         fprintf(stderr, "Cannot write %s\n", argv[2]);
+         return 1;
+         }
+      ghw_trace_sink = host_trace_sink;
+      ghw_trace_start();
+      }
+   #endif
+
+   if (ginit() != 0)
+      {
+      fprintf(stderr, "ginit failed\n");
+      return 1;
+      }
+   GHW_TR->flush();
+   ghw_trace_frame();
+   host_draw();
+   GHW_TR->flush();
+   ghw_trace_frame();
+
+   #ifdef GHW_TRACE
+   if (host_trc != NULL)
+      {
+      ghw_trace_stop();
+      fclose(host_trc);
+      }
+   #endif
+
+   printf("bus bytes: %lu cmd, %lu data, %lu read\n",
+      (unsigned long) ghw_tr_mockstat.cmds,
+      (unsigned long) ghw_tr_mockstat.data,
+      (unsigned long) ghw_tr_mockstat.reads);
+   printf("emulator:  %lu windows, %lu pixels, %lu clipped\n",
+      (unsigned long) hx8357emu_stat.windows,
+      (unsigned long) hx8357emu_stat.pixels,
+      (unsigned long) hx8357emu_stat.clipped);
+   #if (defined( GBUFFER ) && defined( GHW_XMEM_BUF ))
+   printf("xmem:      %lu bank switches\n", (unsigned long) ghw_xmem_switches);
+   #endif
+
+   #ifdef GHW_STATS
+   host_stats();
+   #endif
+
+   if (hx8357emu_save(fname, HOST_VIEW) != 0)
+      {
+      fprintf(stderr, "Cannot write %s\n", fname);
+      return 1;
+      }
+   gexit();
+   return 0;
+   }
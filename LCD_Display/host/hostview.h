@@ -0,0 +1,35 @@
+#ifndef HOSTVIEW_H
+#define HOSTVIEW_H
+/***************************** hostview.h ********************************
+
+   Emulator output view for the host programs (hostmain.c, ghwbench.c)
+
+   Include after gdisp.h so the gdispcfg.h switches are known.
+
+*********************************************************************/
+
+/* Output view matching the MADCTL settings made by ghwinit.c, so the
+   image has the GDISPW x GDISPH application layout */
+#define HOST_VIEW ( VIEW_MY | VIEW_MX | VIEW_MV | VIEW_BGR )
+#ifdef GHW_MIRROR_VER
+   #define VIEW_MY HX8357EMU_MY
+#else
+   #define VIEW_MY 0
+#endif
+#ifdef GHW_MIRROR_HOR
+   #define VIEW_MX HX8357EMU_MX
+#else
+   #define VIEW_MX 0
+#endif
+#ifdef GHW_ROTATED
+   #define VIEW_MV HX8357EMU_MV
+#else
+   #define VIEW_MV 0
+#endif
+#ifdef GHW_COLOR_SWAP
+   #define VIEW_BGR HX8357EMU_BGR
+#else
+   #define VIEW_BGR 0
+#endif
+
+#endif /* HOSTVIEW_H */
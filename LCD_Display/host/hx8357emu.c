@@ -0,0 +1,545 @@
+/***************************** hx8357emu.c ************************************
+
+   HX8357D command stream emulator for host builds, see hx8357emu.h
+
+   The GRAM holds 6 bit color components left aligned in a byte
+   (0x00RRGGBB, RRRRRR00), i.e. the format returned by RAMRD.
+
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ghwtrans.h"
+#include "hx8357emu.h"
+
+/* Command codes */
+#define EMU_SWRESET   0x01
+#define EMU_INVOFF    0x20
+#define EMU_INVON     0x21
+#define EMU_DISPOFF   0x28
+#define EMU_DISPON    0x29
+#define EMU_CASET     0x2A
+#define EMU_RASET     0x2B
+#define EMU_RAMWR     0x2C
+#define EMU_RAMRD     0x2E
+#define EMU_VSCRDEF   0x33
+#define EMU_MADCTL    0x36
+#define EMU_VSCRSADD  0x37
+#define EMU_COLMOD    0x3A
+#define EMU_RAMWRC    0x3C
+#define EMU_RAMRDC    0x3E
+
+HX8357EMU_STAT hx8357emu_stat;
+void (*hx8357emu_wrhook)(uint16_t col, uint16_t row, uint32_t old, uint32_t rgb);
+
+static uint32_t emu_gram[HX8357EMU_ROWS][HX8357EMU_COLS];
+
+static uint8_t  emu_cmd;        /* Current command */
+static uint16_t emu_argn;       /* Parameter bytes received for emu_cmd */
+static uint8_t  emu_args[6];    /* Parameters of window and scroll commands */
+
+static uint16_t emu_sc, emu_ec; /* CASET column window */
+static uint16_t emu_sp, emu_ep; /* RASET page (row) window */
+static uint16_t emu_cc, emu_pc; /* Address counter */
+
+static uint8_t  emu_madctl;
+static uint8_t  emu_colmod;
+static uint8_t  emu_inv;
+static uint8_t  emu_dispon;
+static uint16_t emu_tfa, emu_vsa, emu_bfa, emu_vsp;
+
+static uint8_t  emu_pix[3];     /* Pixel write assembly */
+static uint8_t  emu_pixn;
+static uint8_t  emu_rddummy;    /* Next read is the dummy read */
+static uint8_t  emu_rdn;        /* Read component index 0-2 */
+static uint32_t emu_rdpix;
+
+/*
+   Register defaults after a software reset
+*/
+static void emu_swreset(void)
+   {
+   emu_cmd = 0;
+   emu_argn = 0;
+   emu_sc = 0;
+   emu_ec = HX8357EMU_COLS-1;
+   emu_sp = 0;
+   emu_ep = HX8357EMU_ROWS-1;
+   emu_cc = 0;
+   emu_pc = 0;
+   emu_madctl = 0;
+   emu_colmod = 0x66;
+   emu_inv = 0;
+   emu_dispon = 0;
+   emu_tfa = 0;
+   emu_vsa = HX8357EMU_ROWS;
+   emu_bfa = 0;
+   emu_vsp = 0;
+   emu_pixn = 0;
+   emu_rddummy = 0;
+   emu_rdn = 0;
+   }
+
+void hx8357emu_reset(void)
+   {
+   memset(emu_gram, 0, sizeof(emu_gram));
+   memset(&hx8357emu_stat, 0, sizeof(hx8357emu_stat));
+   emu_swreset();
+   }
+
+void hx8357emu_attach(void)
+   {
+   ghw_tr_mock_sink = hx8357emu_byte;
+   ghw_tr_mock_source = hx8357emu_read;
+   }
+
+/*
+   Map column c, page p through the MADCTL bits in mode to a GRAM column
+   and row. Returns 0 if the position is outside the GRAM
+*/
+static int emu_map(uint8_t mode, uint16_t c, uint16_t p, uint16_t *col, uint16_t *row)
+   {
+   uint16_t mc, mr;
+   if (mode & HX8357EMU_MV)
+      {
+      mc = p;
+      mr = c;
+      }
+   else
+      {
+      mc = c;
+      mr = p;
+      }
+   if ((mc >= HX8357EMU_COLS) || (mr >= HX8357EMU_ROWS))
+      return 0;
+   *col = (mode & HX8357EMU_MX) ? (HX8357EMU_COLS-1-mc) : mc;
+   *row = (mode & HX8357EMU_MY) ? (HX8357EMU_ROWS-1-mr) : mr;
+   return 1;
+   }
+
+/*
+   Advance the address counter inside the window
+*/
+static void emu_next(void)
+   {
+   if (emu_cc >= emu_ec)
+      {
+      emu_cc = emu_sc;
+      if (emu_pc >= emu_ep)
+         {
+         emu_pc = emu_sp;
+         hx8357emu_stat.wraps++;
+         }
+      else
+         emu_pc++;
+      }
+   else
+      emu_cc++;
+   }
+
+static void emu_wrpixel(uint32_t rgb)
+   {
+   uint16_t col, row;
+   if (emu_map(emu_madctl, emu_cc, emu_pc, &col, &row))
+      {
+      if (hx8357emu_wrhook != 0)
+         hx8357emu_wrhook(col, row, emu_gram[row][col], rgb);
+      emu_gram[row][col] = rgb;
+      hx8357emu_stat.pixels++;
+      }
+   else
+      hx8357emu_stat.clipped++;
+   emu_next();
+   }
+
+/*
+   Collect a RAMWR parameter byte, write the pixel when complete
+*/
+static void emu_ramwr(uint8_t dat)
+   {
+   uint8_t r,g,b;
+   emu_pix[emu_pixn++] = dat;
+   if ((emu_colmod & 0x07) == 0x05)
+      {
+      /* 16 bit, RRRRRGGG GGGBBBBB, R and B lsb extended from msb */
+      if (emu_pixn < 2)
+         return;
+      r = emu_pix[0] >> 3;
+      g = (uint8_t)(((emu_pix[0] & 0x07) << 3) | (emu_pix[1] >> 5));
+      b = emu_pix[1] & 0x1f;
+      r = (uint8_t)((r << 1) | (r >> 4));
+      b = (uint8_t)((b << 1) | (b >> 4));
+      emu_wrpixel((((uint32_t) r) << 18) | (((uint32_t) g) << 10) | (((uint32_t) b) << 2));
+      }
+   else
+      {
+      /* 18 bit, RRRRRR** GGGGGG** BBBBBB** */
+      if (emu_pixn < 3)
+         return;
+      emu_wrpixel((((uint32_t)(emu_pix[0] & 0xfc)) << 16) |
+                  (((uint32_t)(emu_pix[1] & 0xfc)) << 8) |
+                   ((uint32_t)(emu_pix[2] & 0xfc)));
+      }
+   emu_pixn = 0;
+   }
+
+static uint16_t emu_arg16(uint8_t i)
+   {
+   return (uint16_t)((((uint16_t) emu_args[i]) << 8) | emu_args[i+1]);
+   }
+
+static void emu_data(uint8_t dat)
+   {
+   if ((emu_cmd == EMU_RAMWR) || (emu_cmd == EMU_RAMWRC))
+      {
+      emu_ramwr(dat);
+      return;
+      }
+   if (emu_argn < sizeof(emu_args))
+      emu_args[emu_argn] = dat;
+   emu_argn++;
+
+   switch (emu_cmd)
+      {
+      case EMU_CASET:
+         if (emu_argn == 4)
+            {
+            emu_sc = emu_arg16(0);
+            emu_ec = emu_arg16(2);
+            }
+         break;
+      case EMU_RASET:
+         if (emu_argn == 4)
+            {
+            emu_sp = emu_arg16(0);
+            emu_ep = emu_arg16(2);
+            }
+         break;
+      case EMU_VSCRDEF:
+         if (emu_argn == 6)
+            {
+            emu_tfa = emu_arg16(0);
+            emu_vsa = emu_arg16(2);
+            emu_bfa = emu_arg16(4);
+            }
+         break;
+      case EMU_VSCRSADD:
+         if (emu_argn == 2)
+            emu_vsp = emu_arg16(0);
+         break;
+      case EMU_MADCTL:
+         if (emu_argn == 1)
+            emu_madctl = dat;
+         break;
+      case EMU_COLMOD:
+         if (emu_argn == 1)
+            emu_colmod = dat;
+         break;
+      default:
+         break;
+      }
+   }
+
+static void emu_command(uint8_t cmd)
+   {
+   hx8357emu_stat.cmds++;
+   emu_cmd = cmd;
+   emu_argn = 0;
+   emu_pixn = 0;  /* A command aborts an incomplete pixel */
+   switch (cmd)
+      {
+      case EMU_SWRESET:
+         emu_swreset();
+         break;
+      case EMU_INVOFF:
+         emu_inv = 0;
+         break;
+      case EMU_INVON:
+         emu_inv = 1;
+         break;
+      case EMU_DISPOFF:
+         emu_dispon = 0;
+         break;
+      case EMU_DISPON:
+         emu_dispon = 1;
+         break;
+      case EMU_CASET:
+      case EMU_RASET:
+         hx8357emu_stat.windows++;
+         break;
+      case EMU_RAMWR:
+         emu_cc = emu_sc;
+         emu_pc = emu_sp;
+         break;
+      case EMU_RAMRD:
+         emu_cc = emu_sc;
+         emu_pc = emu_sp;
+         emu_rddummy = 1;
+         emu_rdn = 0;
+         break;
+      case EMU_RAMRDC:
+         emu_rddummy = 1;
+         emu_rdn = 0;
+         break;
+      default:
+         break;
+      }
+   }
+
+void hx8357emu_byte(uint8_t isdata, uint8_t dat)
+   {
+   if (isdata)
+      emu_data(dat);
+   else
+      emu_command(dat);
+   }
+
+uint8_t hx8357emu_read(void)
+   {
+   uint16_t col, row;
+   uint8_t ret;
+   if ((emu_cmd != EMU_RAMRD) && (emu_cmd != EMU_RAMRDC))
+      return 0;
+   if (emu_rddummy)
+      {
+      emu_rddummy = 0;
+      return 0;
+      }
+   if (emu_rdn == 0)
+      {
+      emu_rdpix = emu_map(emu_madctl, emu_cc, emu_pc, &col, &row) ? emu_gram[row][col] : 0;
+      hx8357emu_stat.reads++;
+      emu_next();
+      }
+   ret = (uint8_t)(emu_rdpix >> (16 - 8*emu_rdn));
+   if (++emu_rdn > 2)
+      emu_rdn = 0;
+   return ret;
+   }
+
+/********************* Output *********************/
+
+uint16_t hx8357emu_width(uint8_t view)
+   {
+   return (view & HX8357EMU_MV) ? HX8357EMU_ROWS : HX8357EMU_COLS;
+   }
+
+uint16_t hx8357emu_height(uint8_t view)
+   {
+   return (view & HX8357EMU_MV) ? HX8357EMU_COLS : HX8357EMU_ROWS;
+   }
+
+int hx8357emu_gram_pos(uint16_t x, uint16_t y, uint8_t view, uint16_t *col, uint16_t *row)
+   {
+   return emu_map(view, x, y, col, row);
+   }
+
+uint32_t hx8357emu_pixel(uint16_t x, uint16_t y, uint8_t view)
+   {
+   uint16_t col, row;
+   uint32_t rgb;
+   if (!emu_dispon || !emu_map(view, x, y, &col, &row))
+      return 0;
+
+   /* Scroll area, the first scanned line shows GRAM row VSP */
+   if ((row >= emu_tfa) && (row < emu_tfa + emu_vsa) && (emu_vsp >= emu_tfa))
+      {
+      row = (uint16_t)(emu_vsp + (row - emu_tfa));
+      if (row >= emu_tfa + emu_vsa)
+         row = (uint16_t)(row - emu_vsa);
+      if (row >= HX8357EMU_ROWS)
+         return 0;
+      }
+
+   rgb = emu_gram[row][col];
+   if ((emu_madctl ^ view) & HX8357EMU_BGR)
+      rgb = ((rgb >> 16) & 0xff) | (rgb & 0xff00) | ((rgb & 0xff) << 16);
+   if (emu_inv)
+      rgb = ~rgb & 0x00fcfcfc;
+   /* Extend 6 bit components to 8 bit */
+   return rgb | ((rgb >> 6) & 0x00030303);
+   }
+
+/* Image being saved */
+static uint16_t emu_imgw, emu_imgh;
+static uint32_t (*emu_imgpixel)(uint16_t x, uint16_t y);
+
+/*
+   Image as 8 bit R,G,B triplets, one row at a time.
+   PNG rows are preceded with a filter type byte (0 = none)
+*/
+static uint8_t *emu_image(int filterbyte, uint32_t *size)
+   {
+   uint16_t w = emu_imgw;
+   uint16_t h = emu_imgh;
+   uint16_t x,y;
+   uint32_t rgb;
+   uint8_t *buf, *p;
+   *size = (uint32_t) h * ((uint32_t) w * 3 + (filterbyte ? 1 : 0));
+   if ((p = buf = (uint8_t *) malloc(*size)) == NULL)
+      return NULL;
+   for (y = 0; y < h; y++)
+      {
+      if (filterbyte)
+         *p++ = 0;
+      for (x = 0; x < w; x++)
+         {
+         rgb = emu_imgpixel(x, y);
+         *p++ = (uint8_t)(rgb >> 16);
+         *p++ = (uint8_t)(rgb >> 8);
+         *p++ = (uint8_t) rgb;
+         }
+      }
+   return buf;
+   }
+
+static uint32_t emu_crc_table[256];
+
+static uint32_t emu_crc(uint32_t crc, const uint8_t *buf, uint32_t len)
+   {
+   uint32_t c;
+   int n,k;
+   if (emu_crc_table[1] == 0)
+      {
+      for (n = 0; n < 256; n++)
+         {
+         c = (uint32_t) n;
+         for (k = 0; k < 8; k++)
+            c = (c & 1) ? (0xedb88320UL ^ (c >> 1)) : (c >> 1);
+         emu_crc_table[n] = c;
+         }
+      }
+   crc = ~crc;
+   while (len--)
+      crc = emu_crc_table[(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+   return ~crc;
+   }
+
+static void emu_put32(uint8_t *p, uint32_t v)
+   {
+   p[0] = (uint8_t)(v >> 24);
+   p[1] = (uint8_t)(v >> 16);
+   p[2] = (uint8_t)(v >> 8);
+   p[3] = (uint8_t) v;
+   }
+
+/*
+   Write a PNG chunk. dat is preceded by 8 free bytes for length and type
+*/
+static int emu_png_chunk(FILE *fp, const char *type, uint8_t *dat, uint32_t len)
+   {
+   uint8_t crc[4];
+   emu_put32(&dat[-8], len);
+   memcpy(&dat[-4], type, 4);
+   emu_put32(crc, emu_crc(0, &dat[-4], len + 4));
+   return ((fwrite(&dat[-8], 1, len + 8, fp) != len + 8) ||
+           (fwrite(crc, 1, 4, fp) != 4)) ? -1 : 0;
+   }
+
+/*
+   PNG with 8 bit RGB and a zlib stream of uncompressed (stored) blocks,
+   so no compression library is needed
+*/
+static int emu_write_png(FILE *fp)
+   {
+   static const uint8_t sig[8] = {0x89,'P','N','G','\r','\n',0x1a,'\n'};
+   uint8_t hdr[8+13];
+   uint8_t end[8];
+   uint8_t *raw, *z, *p;
+   uint32_t rawlen, zlen, i, blk, s1, s2;
+   int ret;
+
+   if ((raw = emu_image(1, &rawlen)) == NULL)
+      return -1;
+   zlen = 2 + rawlen + 5*((rawlen + 0xfffe) / 0xffff) + 4;
+   if ((z = (uint8_t *) malloc(8 + zlen)) == NULL)
+      {
+      free(raw);
+      return -1;
+      }
+   p = &z[8];
+   *p++ = 0x78;   /* Deflate, 32K window */
+   *p++ = 0x01;   /* No dictionary, check bits */
+   for (i = 0; i < rawlen; i += blk)
+      {
+      blk = ((rawlen - i) > 0xffff) ? 0xffff : (rawlen - i);
+      *p++ = (uint8_t)((i + blk == rawlen) ? 1 : 0); /* BFINAL, BTYPE=00 */
+      *p++ = (uint8_t) blk;
+      *p++ = (uint8_t)(blk >> 8);
+      *p++ = (uint8_t) ~blk;
+      *p++ = (uint8_t)(~blk >> 8);
+      memcpy(p, &raw[i], blk);
+      p += blk;
+      }
+   for (i = 0, s1 = 1, s2 = 0; i < rawlen; i++)
+      {
+      s1 = (s1 + raw[i]) % 65521;
+      s2 = (s2 + s1) % 65521;
+      }
+   emu_put32(p, (s2 << 16) | s1);
+
+   emu_put32(&hdr[8], emu_imgw);
+   emu_put32(&hdr[12], emu_imgh);
+   hdr[16] = 8;   /* Bit depth */
+   hdr[17] = 2;   /* Color type RGB */
+   hdr[18] = 0;   /* Compression */
+   hdr[19] = 0;   /* Filter */
+   hdr[20] = 0;   /* No interlace */
+
+   ret = ((fwrite(sig, 1, 8, fp) != 8) ||
+          emu_png_chunk(fp, "IHDR", &hdr[8], 13) ||
+          emu_png_chunk(fp, "IDAT", &z[8], zlen) ||
+          emu_png_chunk(fp, "IEND", &end[8], 0)) ? -1 : 0;
+   free(z);
+   free(raw);
+   return ret;
+   }
+
+static int emu_write_ppm(FILE *fp)
+   {
+   uint8_t *raw;
+   uint32_t rawlen;
+   int ret;
+   if ((raw = emu_image(0, &rawlen)) == NULL)
+      return -1;
+   ret = ((fprintf(fp, "P6\n%u %u\n255\n",
+                   (unsigned) emu_imgw, (unsigned) emu_imgh) < 0) ||
+          (fwrite(raw, 1, rawlen, fp) != rawlen)) ? -1 : 0;
+   free(raw);
+   return ret;
+   }
+
+int hx8357emu_save_image(const char *fname, uint16_t w, uint16_t h,
+                         uint32_t (*pixel)(uint16_t x, uint16_t y))
+   {
+   FILE *fp;
+   size_t len;
+   int ret;
+   if ((fp = fopen(fname, "wb")) == NULL)
+      return -1;
+   emu_imgw = w;
+   emu_imgh = h;
+   emu_imgpixel = pixel;
+   len = strlen(fname);
+   if ((len > 4) && (strcmp(&fname[len-4], ".png") == 0))
+      ret = emu_write_png(fp);
+   else
+      ret = emu_write_ppm(fp);
+   if (fclose(fp) != 0)
+      ret = -1;
+   return ret;
+   }
+
+static uint8_t emu_saveview;
+
+static uint32_t emu_viewpixel(uint16_t x, uint16_t y)
+   {
+   return hx8357emu_pixel(x, y, emu_saveview);
+   }
+
+int hx8357emu_save(const char *fname, uint8_t view)
+   {
+   emu_saveview = view;
+   return hx8357emu_save_image(fname, hx8357emu_width(view), hx8357emu_height(view),
+                               emu_viewpixel);
+   }
@@ -0,0 +1,103 @@
+#ifndef HX8357EMU_H
+#define HX8357EMU_H
+/***************************** hx8357emu.h ********************************
+
+   HX8357D command stream emulator for host builds.
+
+   The emulator is connected to the mock transport (ghwtrans.h) and
+   interprets the command and data bytes generated by the display driver
+   like the controller does. The GRAM content can be saved as a PPM or PNG
+   image, which makes pixel exact comparisons of the driver output
+   possible without a display module.
+
+   Modelled commands:
+      SWRESET  0x01   Register defaults
+      INVOFF   0x20,  INVON 0x21 (output inversion)
+      DISPOFF  0x28,  DISPON 0x29
+      CASET    0x2A,  RASET 0x2B
+      RAMWR    0x2C,  RAMWRC 0x3C
+      RAMRD    0x2E,  RAMRDC 0x3E (dummy byte, then R,G,B 6 bit pr pixel)
+      VSCRDEF  0x33,  VSCRSADD 0x37 (vertical scroll of the output)
+      MADCTL   0x36   MY, MX, MV, BGR
+      COLMOD   0x3A   16 bit (5:6:5, 2 bytes) or 18 bit (6:6:6, 3 bytes)
+   Other commands and their parameters are counted and ignored.
+
+   The address counter runs from the CASET start column to the end
+   column, then continues at the start column on the next row. After the
+   last window row it wraps to the first window row.
+
+*********************************************************************/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GRAM size (native portrait orientation) */
+#define HX8357EMU_COLS  320
+#define HX8357EMU_ROWS  480
+
+/* MADCTL bits */
+#define HX8357EMU_MY    0x80
+#define HX8357EMU_MX    0x40
+#define HX8357EMU_MV    0x20
+#define HX8357EMU_BGR   0x08
+
+typedef struct
+   {
+   uint32_t cmds;       /* Command bytes */
+   uint32_t windows;    /* CASET + RASET commands */
+   uint32_t pixels;     /* Pixels written to GRAM */
+   uint32_t clipped;    /* Pixels written outside the GRAM (lost) */
+   uint32_t wraps;      /* Address counter wraps from window end to window start */
+   uint32_t reads;      /* Pixels read */
+   } HX8357EMU_STAT;
+
+extern HX8357EMU_STAT hx8357emu_stat;
+
+/* Called for each pixel written to GRAM, with the GRAM position, the old
+   and the new value (0x00RRGGBB, 6 bit components), if set */
+extern void (*hx8357emu_wrhook)(uint16_t col, uint16_t row, uint32_t old, uint32_t rgb);
+
+/* Power on state, GRAM is cleared to black */
+void hx8357emu_reset(void);
+
+/* Connect to the mock transport (ghw_tr_mock_sink, ghw_tr_mock_source) */
+void hx8357emu_attach(void);
+
+/* Transport interface, byte written (isdata = D/C level) or read */
+void hx8357emu_byte(uint8_t isdata, uint8_t dat);
+uint8_t hx8357emu_read(void);
+
+/*
+   The output is viewed through the view parameter, using MADCTL bit
+   semantic (MY, MX, MV, BGR) for how the module is mounted.
+   With view equal to the MADCTL value used by the driver the image matches
+   the driver coordinates (GDISPW x GDISPH). With view = 0 the GRAM is
+   shown unmodified (320x480).
+*/
+uint16_t hx8357emu_width(uint8_t view);
+uint16_t hx8357emu_height(uint8_t view);
+
+/* GRAM column and row shown at x,y in view. Returns 0 if outside */
+int hx8357emu_gram_pos(uint16_t x, uint16_t y, uint8_t view, uint16_t *col, uint16_t *row);
+
+/* Displayed pixel at x,y as 0x00RRGGBB. Scroll, inversion and
+   display on/off are included */
+uint32_t hx8357emu_pixel(uint16_t x, uint16_t y, uint8_t view);
+
+/* Save the displayed image. The format is PNG if the file name ends
+   with .png, else binary PPM (P6). Returns 0 if ok */
+int hx8357emu_save(const char *fname, uint8_t view);
+
+/* Save a w x h image where pixel() returns 0x00RRGGBB for x,y, in the
+   same formats as hx8357emu_save(), e.g. for analysis maps */
+int hx8357emu_save_image(const char *fname, uint16_t w, uint16_t h,
+                         uint32_t (*pixel)(uint16_t x, uint16_t y));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX8357EMU_H */
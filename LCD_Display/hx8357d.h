@@ -4,12 +4,12 @@
  * Created: 6/9/2025 5:37:40 PM corrected 6/13/25 12:06 added hx8375d.c
  *  Author: Steve
  */ 
-#include <stdint.h> // for uint8_t
+#include <ghwscript.h> // init script format, GSCR_FLASH qualifier
 
 #ifndef HX8357D_H_
 #define HX8357D_H_
 
-// Declaration only, no initialization here!
-extern const uint8_t hx8357d_init[];
+// Declaration only, no initialization here! (init script in flash)
+extern GCODE SGUCHAR GSCR_FLASH hx8357d_init[];
 
 #endif /* HX8357D_H_ */
\ No newline at end of file
@@ -7,21 +7,22 @@
 #include "hx8357d.h"
 
 // Definition and initialization here, ONLY in this .c file!
-const uint8_t hx8357d_init[] =
+// Stored in flash, script format and GSCR_ macros are described in ghwscript.h
+// Executed step by step by ghw_io_init_step() (ghwioini.c)
+GCODE SGUCHAR GSCR_FLASH hx8357d_init[] =
 {
-	0x01, 0x80 + 150 / 5, // Soft reset, delay 150ms
-	0xB9, 3, 0xFF, 0x83, 0x57, // Set EXTC
-	0xB3, 4, 0x00, 0x00, 0x06, 0x06, // Frame rate
-	0xB6, 1, 0x25, // Display function control
-	0xC0, 2, 0x10, 0x10, // Power control
-	0xC1, 1, 0x41, // Power control 2
-	0xC2, 1, 0x22, // Power control 3
-	0xC5, 2, 0x00, 0x48, // VCOM control
-	0xE0, 15, 0x0F, 0x1F, 0x1C, 0x0C, 0x0F, 0x08, 0x48, 0x98, 0x37, 0x0A, 0x13, 0x04, 0x11, 0x0D, 0x00, // Positive gamma
-	0xE1, 15, 0x0F, 0x32, 0x2E, 0x0B, 0x0D, 0x05, 0x47, 0x75, 0x37, 0x06, 0x10, 0x03, 0x24, 0x20, 0x00, // Negative gamma
-	0x36, 1, 0x48, // Memory access control
-	0x3A, 1, 0x55, // Pixel format (16-bit)
-	0x11, 0x80 + 150 / 5, // Exit sleep mode, delay 150ms
-	0x29, 0x80 + 150 / 5  // Display on, delay 150ms
-	// No trailing comma for last item
-};
\ No newline at end of file
+	GSCR_CMD0_WAIT(0x01, 150), // Soft reset, delay 150ms
+	GSCR_CMD(0xB9, 0xFF, 0x83, 0x57), // Set EXTC
+	GSCR_CMD(0xB3, 0x00, 0x00, 0x06, 0x06), // Frame rate
+	GSCR_CMD(0xB6, 0x25), // Display function control
+	GSCR_CMD(0xC0, 0x10, 0x10), // Power control
+	GSCR_CMD(0xC1, 0x41), // Power control 2
+	GSCR_CMD(0xC2, 0x22), // Power control 3
+	GSCR_CMD(0xC5, 0x00, 0x48), // VCOM control
+	GSCR_CMD(0xE0, 0x0F, 0x1F, 0x1C, 0x0C, 0x0F, 0x08, 0x48, 0x98, 0x37, 0x0A, 0x13, 0x04, 0x11, 0x0D, 0x00), // Positive gamma
+	GSCR_CMD(0xE1, 0x0F, 0x32, 0x2E, 0x0B, 0x0D, 0x05, 0x47, 0x75, 0x37, 0x06, 0x10, 0x03, 0x24, 0x20, 0x00), // Negative gamma
+	GSCR_CMD0_WAIT(0x11, 150), // Exit sleep mode, delay 150ms
+	// MADCTL (0x36) and COLMOD (0x3A) follow gdispcfg.h and are set by ghwinit.c
+	// Display on (0x29) is sent by ghw_init() after the GRAM is cleared
+	GSCR_END
+};
@@ -4,15 +4,31 @@
 * Created: 6/3/2025 5:32:12 PM Modified to spi4.c edits. 
 *  Author: Steve
 * Description:  This file handles SPI communication for the TFT display. Code for communication with other SPI devices (Data SD SPI, HV SPI, Relay SPI) is commented for future expansion.
-*  4 delays commented out in ghwioini.c for debugging. 
+*  Display init delays are timed by the Timer0 1 ms tick (ghw_init_poll()).
 */ 
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <gdisp.h>  
 #include "hx8357d.h"
 #include "bussim.h"
 #include "spi4.h"
 #include "TFT_spi.h" // Includes Chip Select definitions for TFT SPI
+#include <s6d0129x.h> // ghw_init_start(), ghw_init_poll(), ghw_init_tick()
+
+// 1 ms tick, paces the display initialization delays
+ISR(TIMER0_COMPA_vect)
+{
+	ghw_init_tick();
+}
+
+void init_tick_timer(void)
+{
+	TCCR0A = (1<<WGM01); // CTC mode
+	OCR0A = (F_CPU / 64 / 1000) - 1; // 1 kHz with prescaler 64
+	TIMSK0 = (1<<OCIE0A);
+	TCCR0B = (1<<CS01) | (1<<CS00); // Start, prescaler 64
+}
 
 void init_pins(void) 
 {
@@ -28,6 +44,8 @@ int main(void)
 	// Initialize SPI and pins
 	init_pins();
 	init_spi_master();
+	init_tick_timer();
+	sei(); // SPI transmit ring is emptied by the SPI_STC interrupt
 	//Init display hardware and print an error message
 	//on the center of the LCD display module from manual pg 26
 	
@@ -35,7 +53,13 @@ int main(void)
 	DDRB |= (1<<PB7); //Sets PB7 as output, leaves other pins unchanged
 	PORTB |= (1<<PB7); // Sets PB7 high, leaves other pins unchanged
 		
-	ghw_io_init(); // in ghwioini.c
+	// Display power-up runs in steps, paced by the 1 ms tick
+	ghw_init_start();
+	while (ghw_init_poll())
+	{
+		// Bring up other peripherals (SD, HV, relays, comms) here
+	}
+	ginit(); // Display controller is ready, completes without waiting
 	gputs("\nUsing SYSFONT");
 	gselfont(&ariel9);
 	gputs("Using ariel9");
@@ -0,0 +1,231 @@
+#ifndef S6D0129X_H
+#define S6D0129X_H
+/***************************** s6d0129x.h ********************************
+
+   Local extensions to the controller specific definements in s6d0129.h
+
+   The library modules include this header instead of s6d0129.h so
+   definements depending on the display interface used in this project
+   can be adjusted without modifying the library installation.
+
+*********************************************************************/
+
+#include <s6d0129.h>
+#include <ghwstats.h>  /* GHW_STATS counters, GHW_TR */
+
+/* Symbol data reads in ghw_wrsym() and ghw_puterr()
+   GFLASH_RD(p) reads FCODE / PFCODE data (LPM when FCODE is __flash).
+   GSYM_RD(p) reads the ghw_wrsym() symbol data, which is in RAM while
+   ghw_sym_ram is set by ghw_wrsym_ram() */
+#define GFLASH_RD(p) (*(p))
+#if (!defined( GHW_PCSIM ) && defined( __GNUC__ ) && defined( __FLASH ))
+   #define GHW_FLASH_SYM
+   extern SGUCHAR ghw_sym_ram;
+   #define GSYM_RD(p)   ((ghw_sym_ram != 0) ? *((SGUCHAR *)(SGUINT)(p)) : *(p))
+#else
+   #define GSYM_RD(p)   (*(p))
+#endif
+/* ghw_wrsym() for symbol data in RAM (ghwsymwr.c) */
+void ghw_wrsym_ram(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src, SGUINT bw, SGUCHAR mode);
+
+/* Write the same color count times at the current position (ghwinit.c) */
+void ghw_auto_wr_repeat(GCOLOR dat, GBUFINT count);
+
+/* Controller start-up sequence armed by ghw_io_init() (ghwioini.c)
+   Returns ms to wait before next call, or GHW_IO_INIT_DONE */
+#define GHW_IO_INIT_DONE 0xFFFF
+SGUINT ghw_io_init_step(void);
+
+/* Non-blocking display initialization (ghwinit.c)
+   ghw_init_start() begins the initialization, ghw_init_poll() advances it
+   and returns != 0 while it is in progress. ghw_init_tick() must be called
+   every 1 ms (ex from a timer interrupt) while ghw_init_poll() is used.
+   A following ginit() / ghw_init() call completes without hardware access */
+SGBOOL ghw_init_start(void);
+SGUCHAR ghw_init_poll(void);
+void ghw_init_tick(void);
+
+#ifdef GBUFFER
+/* Dirty rectangle list flushed by ghw_updatehw() (ghwbuf.c).
+   The driver modules mark each modified area with ghw_invalrect().
+   invalrect(x,y) (one corner pr call) is kept for other callers, it makes
+   the next flush use the bounding box of all areas */
+void ghw_invalrect(GXT ltx, GYT lty, GXT rbx, GYT rby);
+void ghw_invalpoint(GXT x, GYT y);
+void ghw_flush_all(void);
+/* Time sliced ghw_updatehw(). Writes at most budget pixels of the dirty
+   areas and keeps the position (row and column) for the next call, also
+   with ghw_setupdate(0). Returns != 0 while more is to be written */
+SGUCHAR ghw_updatehw_step(GBUFINT budget);
+/* Forget the dirty areas and the flush in progress (ghw_init_start()) */
+void ghw_updatehw_reset(void);
+#undef  invalrect
+#define invalrect(x,y) ghw_invalpoint((GXT)(x),(GYT)(y))
+
+#ifdef GHW_ROW_HASH
+/* Forget the row segment hashes of the flushed content, call when the
+   display is written without the buffer (ghwbuf.c) */
+void ghw_rowhash_inval(void);
+#endif
+
+#ifdef GHW_XMEM_BUF
+/* Frame buffer in bank switched external SRAM (ghwxmem.c).
+   A bank holds GHW_XMEM_ROWS whole rows, GINDEX() returns the bank in
+   bit 16-23 and the pixel offset in the bank in bit 0-15 */
+#ifndef GHW_XMEM_BASE
+  #define GHW_XMEM_BASE      0x8000  /* Window address */
+#endif
+#ifndef GHW_XMEM_BANK_SIZE
+  #define GHW_XMEM_BANK_SIZE 0x8000  /* Window size in bytes */
+#endif
+#if   defined( GHW_INDEXED_BUF )
+  #define GHW_XMEM_ROWS (GHW_XMEM_BANK_SIZE * 8L / (GDISPW * GHW_INDEXED_BUF))
+#elif (GDISPPIXW <= 8)
+  #define GHW_XMEM_ROWS (GHW_XMEM_BANK_SIZE / GDISPW)
+#elif (GDISPPIXW <= 16)
+  #define GHW_XMEM_ROWS (GHW_XMEM_BANK_SIZE / (GDISPW*2))
+#else
+  #define GHW_XMEM_ROWS (GHW_XMEM_BANK_SIZE / (GDISPW*4))
+#endif
+#undef  GINDEX
+#define GINDEX(x,y) ((((GBUFINT)((y) / GHW_XMEM_ROWS)) << 16) | \
+                     (GBUFINT)((SGUINT)((y) % GHW_XMEM_ROWS) * GDISPW + (x)))
+#define GHW_XMEM_BANKS ((GDISPH + GHW_XMEM_ROWS - 1) / GHW_XMEM_ROWS) /* Frame buffer banks */
+#ifdef GHW_ROW_HASH
+  /* The row hash table (ghwbuf.c) is kept in the bank after the frame buffer */
+  #define GHW_XMEM_HASH  (((GBUFINT) GHW_XMEM_BANKS) << 16)
+  #define GHW_XMEM_USED  (GHW_XMEM_BANKS + 1)
+#else
+  #define GHW_XMEM_USED  GHW_XMEM_BANKS
+#endif
+void ghw_xmem_init(void);
+/* Byte at offset bit 0-15 in the bank in bit 16-23 */
+SGUCHAR *ghw_xmem_bptr(GBUFINT boffs);
+#ifndef GHW_INDEXED_BUF
+GCOLOR *ghw_xmem_ptr(GBUFINT idx);
+GCOLOR ghw_xmem_rd(GBUFINT idx);
+void ghw_xmem_wr(GBUFINT idx, GCOLOR color);
+void ghw_xmem_copy(GBUFINT dst, GBUFINT src, GBUFINT n);
+#endif
+#ifndef __AVR__
+extern SGULONG ghw_xmem_switches;  /* Bank changes in the host model */
+#endif
+#endif /* GHW_XMEM_BUF */
+
+#ifdef GHW_INDEXED_BUF
+/* Indexed color frame buffer, GHW_INDEXED_BUF bits pr pixel (ghwibuf.c),
+   in the XMEM banks with GHW_XMEM_BUF */
+#ifndef GHW_XMEM_BUF
+extern SGUCHAR ghw_ibuf[];
+#endif
+SGUCHAR ghw_ibuf_index(GCOLOR color);
+void ghw_ibuf_palette(void);
+GCOLOR ghw_ibuf_rd(GBUFINT idx);
+void ghw_ibuf_wr(GBUFINT idx, GCOLOR color);
+void ghw_ibuf_fill(GBUFINT idx, GBUFINT n, GCOLOR color);
+void ghw_ibuf_copy(GBUFINT dst, GBUFINT src, GBUFINT n);
+void ghw_ibuf_invert(GBUFINT idx, GBUFINT n, GCOLOR fore, GCOLOR back);
+void ghw_ibuf_flush(GBUFINT idx, GBUFINT n);
+#define GBUF_RD(idx)        ghw_ibuf_rd((GBUFINT)(idx))
+#define GBUF_WR(idx, color) ghw_ibuf_wr((GBUFINT)(idx), (color))
+#elif defined( GHW_XMEM_BUF )
+#define GBUF_RD(idx)        ghw_xmem_rd((GBUFINT)(idx))
+#define GBUF_WR(idx, color) ghw_xmem_wr((GBUFINT)(idx), (color))
+#define GBUF_PTR(idx)       ghw_xmem_ptr((GBUFINT)(idx))
+#else
+/* Frame buffer pixel access */
+#define GBUF_RD(idx)        (gbuf[(idx)])
+#define GBUF_WR(idx, color) (gbuf[(idx)] = (color))
+#define GBUF_PTR(idx)       (&gbuf[(idx)])
+#endif
+#endif
+
+#ifdef GHW_WINDOW_CACHE
+/* Forget the CASET / RASET window cached by ghw_set_xyrange() (ghwinit.c)
+   Call after any controller access outside the ghw_ functions */
+void ghw_win_invalidate(void);
+#endif
+
+#if (defined( GBUFFER ) || !defined( GHW_NO_LCD_READ_SUPPORT ))
+/* Read n pixels after ghw_auto_rd_start(), in bus bursts where the
+   transport supports it (ghwinit.c) */
+void ghw_auto_rd_block(GCOLOR *buf, SGUINT n);
+#endif
+
+#if (!defined( GBUFFER ) && !defined( GHW_NO_LCD_READ_SUPPORT ))
+/* Read pixels xb..xe in row ys, modify them with op (if not NULL) and
+   write them to row yd, in chunks of GHW_RMW_CHUNK pixels (ghwinit.c) */
+typedef void (*GHW_RMW_OP)(GCOLOR *buf, SGUINT n);
+void ghw_rmw_row(GXT xb, GXT xe, GYT ys, GYT yd, GHW_RMW_OP op);
+#endif
+
+/* Header of the ghw_rdblk() / ghw_wrblk() buffer (ghwblkrw.c) */
+typedef struct
+   {
+   GXT lx;
+   GYT ly;
+   GXT rx;
+   GYT ry;
+   SGUCHAR dat[1];
+   } GHW_BLK_HEADER, *PGHW_BLK_HEADER;
+
+#ifdef GHW_BAND_ROWS
+/* Band rendering in non-buffered mode (ghwband.c)
+   ghw_band_begin() starts recording the ghw_fill(), ghw_rectangle(),
+   ghw_setpixel(), ghw_wrsym() and ghw_wrblk() calls of a frame.
+   ghw_band_end() renders the frame GHW_BAND_ROWS rows at a time and
+   writes each band with one window and one burst. Returns != 0 if the
+   recording had to be ended early */
+void ghw_band_begin(void);
+SGUCHAR ghw_band_end(void);
+
+#define GHW_BAND_OFF  0   /* Drawing directly */
+#define GHW_BAND_REC  1   /* Recording into the display list */
+#define GHW_BAND_DRAW 2   /* Replaying into the band buffer */
+extern SGUCHAR ghw_band_state;
+/* Record a call, returns 0 if it must be drawn directly */
+SGUCHAR ghw_band_rec_fill(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUINT pattern);
+SGUCHAR ghw_band_rec_rect(GXT ltx, GYT lty, GXT rbx, GYT rby, GCOLOR color);
+SGUCHAR ghw_band_rec_pixel(GXT x, GYT y, GCOLOR color);
+SGUCHAR ghw_band_rec_wrsym(GXT ltx, GYT lty, GXT rbx, GYT rby, PGSYMBYTE src, SGUINT bw, SGUCHAR mode);
+SGUCHAR ghw_band_rec_wrblk(GXT ltx, GYT lty, GXT rbx, GYT rby, SGUCHAR *src);
+/* Render the recorded part now, used by the functions which can not be recorded */
+void ghw_band_sync(void);
+/* Band buffer access while replaying */
+void ghw_band_xyrange(GXT xb, GYT yb, GXT xe, GYT ye);
+void ghw_band_wr(GCOLOR dat);
+void ghw_band_wr_repeat(GCOLOR dat, GBUFINT count);
+GCOLOR ghw_band_rd(void);
+/* Write count pixels stored msb first at the current position (ghwinit.c) */
+void ghw_auto_wr_burst(const SGUCHAR *buf, GBUFINT count);
+#endif
+
+#ifdef GHW_HW_SCROLL
+/* Scroll the full width rows lty..rby lines up with the controller
+   vertical scroll (ghwinit.c). Returns 0 if done, else the area must be
+   scrolled by read back and rewrite */
+SGUCHAR ghw_vscroll(GYT lty, GYT rby, GYT lines);
+/* The full width rows lty..rby are overwritten, ends the scrolled state
+   if they cover the scroll area (ghwinit.c) */
+void ghw_vscroll_cover(GYT lty, GYT rby);
+#endif
+
+#if (defined( GHW_USE_TRANSPORT ) && !defined( GHW_NOHDW ))
+   #include <ghwtrans.h>
+
+   /* Pixel data is streamed in a burst, closing a write sequence
+      flushes the transport and releases the bus */
+   #undef  ghw_auto_wr_end
+   #undef  _ghw_auto_wr_end
+   #ifdef GHW_WRITE_COMBINE
+   /* ghw_auto_wr_end() is the write combining flush point (ghwinit.c) */
+   void ghw_wc_flush(void);
+   #define ghw_auto_wr_end()  ghw_wc_flush()
+   #define _ghw_auto_wr_end() ghw_wc_flush()
+   #else
+   #define ghw_auto_wr_end()  GHW_TR->flush()
+   #define _ghw_auto_wr_end() GHW_TR->flush()
+   #endif
+#endif
+
+#endif /* S6D0129X_H */
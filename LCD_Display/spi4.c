@@ -24,6 +24,10 @@
 #include <avr/io.h>
 #include "spi4.h"
 #include <stdint.h>
+#ifdef SPI_TX_RING
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#endif
 
 
 void init_spi_master(void)
@@ -63,8 +67,221 @@ void spi_mode(uint8_t mode)  // 0 is normal default.
 	}
 }
 
+#ifdef SPI_TX_RING
+
+// Interrupt driven transmit ring.
+// The producer (SPI_Write) queues bytes and returns at once, the SPI_STC
+// interrupt loads the next byte into SPDR each time the shifter is done.
+// Received bytes are discarded, so only write-only devices (the TFT during
+// RAMWR) may use the ring. SPI_Transfer() drains the ring before it starts
+// a normal polled read/write transfer.
+// If global interrupts are disabled the ring is drained by polling SPIF.
+
+#define SPI_TX_MASK (SPI_TX_RING_SIZE - 1)
+
+static volatile uint8_t spi_tx_buf[SPI_TX_RING_SIZE];
+static volatile uint8_t spi_tx_head;      // next free slot, written by producer only
+static volatile uint8_t spi_tx_tail;      // next byte to send, written by ISR only
+static volatile uint8_t spi_tx_active;    // 1 while the shifter is busy with ring data
+static volatile uint8_t *volatile spi_tx_cs_port; // CS to release when the ring drains
+static volatile uint8_t spi_tx_cs_mask;
+static uint8_t spi_tx_hiwater;            // max bytes waiting in the ring
+static uint16_t spi_tx_stalls;            // times the producer found the ring full
+
+// Shifter is done (SPIF set): load the next byte or go idle
+static void spi_tx_next(void)
+{
+	uint8_t t = spi_tx_tail;
+	if (t != spi_tx_head)
+	{
+		SPDR = spi_tx_buf[t];
+		spi_tx_tail = (t + 1) & SPI_TX_MASK;
+	}
+	else
+	{
+		(void) SPDR;  // clear SPIF when called by polling
+		SPCR &= ~(1 << SPIE);
+		spi_tx_active = 0;
+		if (spi_tx_cs_port)
+		{
+			*spi_tx_cs_port |= spi_tx_cs_mask; // release CS of the finished burst
+			spi_tx_cs_port = 0;
+		}
+	}
+}
+
+ISR(SPI_STC_vect)
+{
+	spi_tx_next();
+}
+
+// Service the shifter by hand when the interrupt cannot run
+static void spi_tx_poll(void)
+{
+	if (!(SREG & (1 << SREG_I)) && (SPSR & (1 << SPIF)))
+		spi_tx_next();
+}
+
+// Queue a byte for transmission. Only waits when the ring is full.
+void SPI_Write(uint8_t data)
+{
+	uint8_t h = spi_tx_head;
+	uint8_t n = (h + 1) & SPI_TX_MASK;
+	uint8_t used;
+
+	if (n == spi_tx_tail)
+	{
+		spi_tx_stalls++;  // ring full, producer has to wait
+		while (n == spi_tx_tail)
+			spi_tx_poll();
+	}
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (!spi_tx_active)
+		{
+			// Shifter idle, start it directly
+			spi_tx_active = 1;
+			SPDR = data;
+			SPCR |= (1 << SPIE);
+		}
+		else
+		{
+			spi_tx_buf[h] = data;
+			spi_tx_head = n;
+			used = (n - spi_tx_tail) & SPI_TX_MASK;
+			if (used > spi_tx_hiwater)
+				spi_tx_hiwater = used;
+		}
+	}
+}
+
+// Wait until the ring is empty and the last byte has left the shifter
+void SPI_Wait(void)
+{
+	while (spi_tx_active)
+		spi_tx_poll();
+}
+
+// Release a chip select once all queued bytes are sent, without waiting.
+// The caller must SPI_Wait() before it changes D/C or selects another device.
+void SPI_WriteEnd(volatile uint8_t *cs_port, uint8_t cs_mask)
+{
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		if (spi_tx_active)
+		{
+			spi_tx_cs_mask = cs_mask;
+			spi_tx_cs_port = cs_port;
+		}
+		else
+			*cs_port |= cs_mask;
+	}
+}
+
+// Ring usage figures, used to size SPI_TX_RING_SIZE
+uint8_t SPI_TxHighWater(void)
+{
+	return spi_tx_hiwater;
+}
+
+uint16_t SPI_TxStalls(void)
+{
+	uint16_t n;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		n = spi_tx_stalls;
+	}
+	return n;
+}
+
+void SPI_TxStatsReset(void)
+{
+	spi_tx_hiwater = 0;
+	spi_tx_stalls = 0;
+}
+
+#else /* SPI_TX_RING */
+
+static volatile uint8_t spi_busy; // 1 while a byte started by SPI_Write() is still shifting
+
+// Start shifting a byte without waiting for it to complete.
+// Only the previous byte is waited for, so the caller can prepare the next
+// byte while the current one is on the wire. Received data is discarded.
+void SPI_Write(uint8_t data)
+{
+	if (spi_busy)
+	{
+		while (!(SPSR & (1 << SPIF)));
+	}
+	SPDR = data;
+	spi_busy = 1;
+}
+
+// Wait for the last byte started by SPI_Write() to leave the shifter.
+// Must be called before CS is raised at the end of a burst.
+void SPI_Wait(void)
+{
+	if (spi_busy)
+	{
+		while (!(SPSR & (1 << SPIF)));
+		(void) SPDR;  // clear SPIF
+		spi_busy = 0;
+	}
+}
+
+// Release a chip select after the last SPI_Write()
+void SPI_WriteEnd(volatile uint8_t *cs_port, uint8_t cs_mask)
+{
+	SPI_Wait();
+	*cs_port |= cs_mask;
+}
+
+#endif /* SPI_TX_RING */
+
+// Send count copies of the byte pair hi,lo (one RGB565 pixel).
+// Queued data is sent first, then SPDR is fed directly by a polled loop
+// unrolled to 4 pixels: no per-byte call, ring or interrupt overhead, so
+// at high SPI clock rates the bus is kept busy. Returns when the last byte
+// has left the shifter.
+#define SPI_PUT(d)  do { SPDR = (d); while (!(SPSR & (1 << SPIF))); } while(0)
+
+void SPI_WriteRepeat(uint8_t hi, uint8_t lo, uint32_t count)
+{
+	uint32_t n = count >> 2;
+	uint8_t r = (uint8_t) count & 3;
+
+	SPI_Wait();
+	while (n--)
+	{
+		SPI_PUT(hi); SPI_PUT(lo);
+		SPI_PUT(hi); SPI_PUT(lo);
+		SPI_PUT(hi); SPI_PUT(lo);
+		SPI_PUT(hi); SPI_PUT(lo);
+	}
+	while (r--)
+	{
+		SPI_PUT(hi); SPI_PUT(lo);
+	}
+	(void) SPDR;  // clear SPIF
+}
+
+// Read len bytes, 0xFF is clocked out for each.
+// Queued data is sent first, then SPDR is polled directly without the
+// per-byte call and wait of SPI_Transfer().
+void SPI_ReadBurst(uint8_t *buf, uint16_t len)
+{
+	SPI_Wait();
+	while (len--)
+	{
+		SPDR = 0xFF;
+		while (!(SPSR & (1 << SPIF)));
+		*buf++ = SPDR;
+	}
+}
+
 uint8_t SPI_Transfer(uint8_t data)
 {
+	SPI_Wait();  // let any queued or pipelined write finish first
 	SPDR = data;
 	while (!(SPSR & (1 << SPIF)));
 	return SPDR;
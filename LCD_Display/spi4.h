@@ -44,6 +44,13 @@
 //#define RLY_SPI_CS_PIN 6      /* Pin number for Relay SPI Chip Select 
 //#define RLY_SPI_CS (1 << RLY_SPI_CS_PIN) /* Bit mask for Relay SPI Chip Select 
 
+/* Interrupt driven transmit ring for SPI_Write() (see spi4.c).
+   Comment out SPI_TX_RING to use polled writes only.
+   Size must be a power of 2, max 256. Check SPI_TxHighWater() and
+   SPI_TxStalls() to tune it. Requires sei() in main(). */
+#define SPI_TX_RING
+#define SPI_TX_RING_SIZE 64
+
 /* Utility macros for Chip Select */
 #define SELECT_CS(port, cs_pin) ((port) &= ~(cs_pin)) // Activate (clears) CS 
 #define DESELECT_CS(port, cs_pin) ((port) |= (cs_pin)) //Deactivate Chip Select
@@ -52,6 +59,16 @@
 void init_spi_master(void);
 void spi_mode(unsigned char mode);
 uint8_t SPI_Transfer(uint8_t data);
+void SPI_Write(uint8_t data); // queued/pipelined write, received data is discarded
+void SPI_Wait(void);          // complete all pending SPI_Write()
+void SPI_WriteEnd(volatile uint8_t *cs_port, uint8_t cs_mask); // raise CS after the last SPI_Write()
+void SPI_WriteRepeat(uint8_t hi, uint8_t lo, uint32_t count); // count x hi,lo, polled and unrolled
+void SPI_ReadBurst(uint8_t *buf, uint16_t len); // read len bytes, 0xFF is sent
+#ifdef SPI_TX_RING
+uint8_t SPI_TxHighWater(void);  // max bytes queued since last reset
+uint16_t SPI_TxStalls(void);    // times SPI_Write() waited on a full ring
+void SPI_TxStatsReset(void);
+#endif
 uint8_t SPI_TransferTx16(unsigned char cs_pin, unsigned char a, unsigned char b);
 uint8_t SPI_TransferTx16_SingleCS(unsigned char cs_pin, unsigned char a, unsigned char b);
 
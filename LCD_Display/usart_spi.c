@@ -0,0 +1,125 @@
+/*
+ * usart_spi.c
+ *
+ * USART1 used as a SPI master (MSPIM), see usart_spi.h for pins.
+ *
+ * use:
+ * Call init_usart_spi() once, then select the device CS and use
+ * USART_SPI_Transfer() or USART_SPI_Write()/USART_SPI_Wait() as with spi4.c.
+ * Only mode 0, MSB first is set up (what the TFT requires).
+ */ 
+#include <avr/io.h>
+#include <util/atomic.h>
+#include "usart_spi.h"
+#include <stdint.h>
+
+static uint8_t usart_busy; // 1 while bytes from USART_SPI_Write() may still be shifting
+
+void init_usart_spi(void)
+{
+	UBRR1 = 0;                        // Baud rate must be 0 while enabling
+	USART_SPI_DDR |= (USART_SPI_XCK | USART_SPI_TXD); // XCK as output selects master mode
+	UCSR1C = (1<<UMSEL11)|(1<<UMSEL10); // MSPIM, mode 0, MSB first
+	UCSR1B = (1<<RXEN1)|(1<<TXEN1);
+	UBRR1 = USART_SPI_UBRR;           // Set rate after transmitter is enabled
+}
+
+// Load a byte as soon as the tx buffer has room.
+// Received data is left in the receiver and discarded by the next transfer.
+// TXC is cleared after UDR1 is loaded: a byte still shifting then hands over
+// to the new one without setting TXC, so TXC only shows the end of this byte.
+// Cleared before, the previous byte could set it again in between and
+// USART_SPI_Wait() would return while this byte is on the wire.
+// Interrupts are held off so the new byte can not complete before the clear.
+void USART_SPI_Write(uint8_t data)
+{
+	while (!(UCSR1A & (1 << UDRE1)));
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		UDR1 = data;
+		UCSR1A = (1 << TXC1);  // clear transmit complete, set again after this byte
+	}
+	usart_busy = 1;
+}
+
+// Wait until the tx buffer and the shifter are empty.
+// Must be called before CS is raised at the end of a burst.
+void USART_SPI_Wait(void)
+{
+	if (usart_busy)
+	{
+		while (!(UCSR1A & (1 << TXC1)));
+		usart_busy = 0;
+	}
+}
+
+// Send count copies of the byte pair hi,lo (one RGB565 pixel).
+// Loop unrolled to 4 pixels, the double buffered UDR keeps the bus busy
+// without gaps. The last byte goes through USART_SPI_Write() so
+// USART_SPI_Wait() sees the end of the stream.
+#define USART_PUT(d)  do { while (!(UCSR1A & (1 << UDRE1))); UDR1 = (d); } while(0)
+
+void USART_SPI_WriteRepeat(uint8_t hi, uint8_t lo, uint32_t count)
+{
+	uint32_t n;
+	uint8_t r;
+
+	if (count == 0)
+		return;
+	count--;          // last pixel is sent below
+	n = count >> 2;
+	r = (uint8_t) count & 3;
+	while (n--)
+	{
+		USART_PUT(hi); USART_PUT(lo);
+		USART_PUT(hi); USART_PUT(lo);
+		USART_PUT(hi); USART_PUT(lo);
+		USART_PUT(hi); USART_PUT(lo);
+	}
+	while (r--)
+	{
+		USART_PUT(hi); USART_PUT(lo);
+	}
+	USART_PUT(hi);
+	USART_SPI_Write(lo);
+}
+
+uint8_t USART_SPI_Transfer(uint8_t data)
+{
+	USART_SPI_Wait();
+	while (UCSR1A & (1 << RXC1))
+		(void) UDR1;       // drop bytes received during writes
+	UDR1 = data;
+	while (!(UCSR1A & (1 << RXC1)));
+	return UDR1;
+}
+
+// Read len bytes, 0xFF is clocked out for each.
+// The next dummy byte is loaded while the current one is shifted, so the
+// read runs without gaps. The receiver holds 2 bytes, the one ahead in
+// the tx buffer is always collected before it can overrun.
+// The clock is lowered to USART_SPI_READ_UBRR for the read.
+void USART_SPI_ReadBurst(uint8_t *buf, uint16_t len)
+{
+	uint16_t tx = len;
+
+	if (len == 0)
+		return;
+	USART_SPI_Wait();
+	while (UCSR1A & (1 << RXC1))
+		(void) UDR1;       // drop bytes received during writes
+	UBRR1 = USART_SPI_READ_UBRR;
+	UDR1 = 0xFF;
+	tx--;
+	while (len--)
+	{
+		if (tx)
+		{
+			USART_PUT(0xFF);
+			tx--;
+		}
+		while (!(UCSR1A & (1 << RXC1)));
+		*buf++ = UDR1;
+	}
+	UBRR1 = USART_SPI_UBRR;
+}
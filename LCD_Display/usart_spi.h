@@ -0,0 +1,39 @@
+/*
+ * usart_spi.h
+ *
+ * Description:
+ * USART1 in Master SPI Mode (MSPIM) for the Atmega2560.
+ * The USART transmit buffer is double buffered, so a new byte can be loaded
+ * while the previous one is shifted out and bytes follow each other without
+ * the gap the single buffered SPDR of the SPI module leaves.
+ *
+ * Pins (fixed by the USART1 hardware):
+ * TXD1 = MOSI (PD3), RXD1 = MISO (PD2), XCK1 = SCK (PD5)
+ * Chip Select is handled by the device .h files as with spi4.h
+ */ 
+
+
+#ifndef USART_SPI_H_
+#define USART_SPI_H_
+
+#include <avr/io.h>
+
+#define USART_SPI_DDR  DDRD
+#define USART_SPI_XCK  (1 << 5)  /* Clock Pin (PD5) */
+#define USART_SPI_TXD  (1 << 3)  /* Master-Out Slave-In (PD3) */
+
+/* SCK = fck / (2 * (USART_SPI_UBRR + 1)), 0 gives fck/2 = 8 MHz at 16 MHz */
+#define USART_SPI_UBRR 0
+/* SCK used by USART_SPI_ReadBurst(). The TFT read cycle is longer than the
+   write cycle (HX8357D: 150 ns min), 1 gives fck/4 = 4 MHz at 16 MHz */
+#define USART_SPI_READ_UBRR 1
+
+// USART SPI Function Declarations
+void init_usart_spi(void);                // SPI mode 0, MSB first
+uint8_t USART_SPI_Transfer(uint8_t data); // write and read one byte
+void USART_SPI_Write(uint8_t data);       // waits only for room in the tx buffer
+void USART_SPI_Wait(void);                // complete all pending USART_SPI_Write()
+void USART_SPI_WriteRepeat(uint8_t hi, uint8_t lo, uint32_t count); // count x hi,lo, unrolled
+void USART_SPI_ReadBurst(uint8_t *buf, uint16_t len); // read len bytes at the read clock
+
+#endif /* USART_SPI_H_ */